@@ -0,0 +1,256 @@
+/*
+ * BodyStore.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "BodyStore.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <cmath>
+
+#include <Thor/Vectors.hpp>
+
+#include "sprites/abstract/Sprite.h"
+
+/**
+ * Gives all sprites that are still inserted their values back.
+ */
+BodyStore::~BodyStore() {
+	for (const auto& sprite : mSprites)
+		detach(*sprite);
+}
+
+/**
+ * Adds an inactive slot for sprite and moves its position, speed and mask
+ * into it. A sprite can only be in one store at a time.
+ */
+void
+BodyStore::insert(std::shared_ptr<Sprite> sprite) {
+	assert(sprite->mBodies == nullptr);
+	mX.push_back(sprite->mPosition.x);
+	mY.push_back(sprite->mPosition.y);
+	mSpeedX.push_back(sprite->mSpeed.x);
+	mSpeedY.push_back(sprite->mSpeed.y);
+	mOffsetX.push_back(0);
+	mOffsetY.push_back(0);
+	mRadius.push_back(thor::length(sprite->getHalfSize()));
+	mReach.push_back(mRadius.back());
+	mCategory.push_back(sprite->getCategory());
+	mMask.push_back(sprite->mMask);
+	sprite->mBodies = this;
+	sprite->mSlot = mSprites.size();
+	mSprites.push_back(sprite);
+}
+
+/**
+ * Copies the values of sprite back into it and removes its slot by moving
+ * the last slot into its place.
+ */
+void
+BodyStore::remove(Sprite& sprite) {
+	assert(sprite.mBodies == this);
+	deactivate(sprite);
+	swap(sprite.mSlot, mSprites.size() - 1);
+	detach(sprite);
+	mX.pop_back();
+	mY.pop_back();
+	mSpeedX.pop_back();
+	mSpeedY.pop_back();
+	mOffsetX.pop_back();
+	mOffsetY.pop_back();
+	mRadius.pop_back();
+	mReach.pop_back();
+	mCategory.pop_back();
+	mMask.pop_back();
+	mSprites.pop_back();
+}
+
+/**
+ * Moves sprite to the active slots, which are visited by predict and
+ * integrate. Does nothing if it is already active.
+ */
+void
+BodyStore::activate(Sprite& sprite) {
+	if (sprite.mSlot < mActiveCount)
+		return;
+	swap(sprite.mSlot, mActiveCount);
+	mActiveCount++;
+}
+
+/**
+ * Moves sprite out of the active slots and clears its offset, so that it
+ * no longer moves. Does nothing if it is not active.
+ */
+void
+BodyStore::deactivate(Sprite& sprite) {
+	if (sprite.mSlot >= mActiveCount)
+		return;
+	mActiveCount--;
+	swap(sprite.mSlot, mActiveCount);
+	size_t index = sprite.mSlot;
+	mOffsetX[index] = 0;
+	mOffsetY[index] = 0;
+	mReach[index] = mRadius[index];
+}
+
+/**
+ * Exchanges the values of two slots, and the slots stored in their sprites.
+ */
+void
+BodyStore::swap(size_t first, size_t second) {
+	if (first == second)
+		return;
+	std::swap(mX[first], mX[second]);
+	std::swap(mY[first], mY[second]);
+	std::swap(mSpeedX[first], mSpeedX[second]);
+	std::swap(mSpeedY[first], mSpeedY[second]);
+	std::swap(mOffsetX[first], mOffsetX[second]);
+	std::swap(mOffsetY[first], mOffsetY[second]);
+	std::swap(mRadius[first], mRadius[second]);
+	std::swap(mReach[first], mReach[second]);
+	std::swap(mCategory[first], mCategory[second]);
+	std::swap(mMask[first], mMask[second]);
+	std::swap(mSprites[first], mSprites[second]);
+	mSprites[first]->mSlot = first;
+	mSprites[second]->mSlot = second;
+}
+
+/**
+ * Copies the values of the slot of sprite into sprite, which then no longer
+ * reads them from this store.
+ */
+void
+BodyStore::detach(Sprite& sprite) {
+	size_t index = sprite.mSlot;
+	sprite.mPosition = Vector2f(mX[index], mY[index]);
+	sprite.mSpeed = Vector2f(mSpeedX[index], mSpeedY[index]);
+	sprite.mMask = mMask[index];
+	sprite.mBodies = nullptr;
+}
+
+size_t
+BodyStore::getCount() const {
+	return mSprites.size();
+}
+
+size_t
+BodyStore::getActiveCount() const {
+	return mActiveCount;
+}
+
+Vector2f
+BodyStore::getPosition(const Sprite& sprite) const {
+	return Vector2f(mX[sprite.mSlot], mY[sprite.mSlot]);
+}
+
+void
+BodyStore::setPosition(const Sprite& sprite, const Vector2f& position) {
+	mX[sprite.mSlot] = position.x;
+	mY[sprite.mSlot] = position.y;
+}
+
+Vector2f
+BodyStore::getSpeed(const Sprite& sprite) const {
+	return Vector2f(mSpeedX[sprite.mSlot], mSpeedY[sprite.mSlot]);
+}
+
+void
+BodyStore::setSpeed(const Sprite& sprite, const Vector2f& speed) {
+	mSpeedX[sprite.mSlot] = speed.x;
+	mSpeedY[sprite.mSlot] = speed.y;
+}
+
+unsigned short
+BodyStore::getMask(const Sprite& sprite) const {
+	return mMask[sprite.mSlot];
+}
+
+void
+BodyStore::setMask(const Sprite& sprite, unsigned short mask) {
+	mMask[sprite.mSlot] = mask;
+}
+
+/**
+ * Returns the movement of sprite within the current step.
+ */
+Vector2f
+BodyStore::getOffset(const Sprite& sprite) const {
+	return Vector2f(mOffsetX[sprite.mSlot], mOffsetY[sprite.mSlot]);
+}
+
+/**
+ * Changes the movement of sprite within the current step, after a
+ * collision. Does not change its reach.
+ */
+void
+BodyStore::setOffset(const Sprite& sprite, const Vector2f& offset) {
+	mOffsetX[sprite.mSlot] = offset.x;
+	mOffsetY[sprite.mSlot] = offset.y;
+}
+
+/**
+ * Returns the distance from the position of sprite within which it may
+ * collide during the current step, on each axis.
+ */
+float
+BodyStore::getReach(const Sprite& sprite) const {
+	return mReach[sprite.mSlot];
+}
+
+/**
+ * Returns the largest reach of any active body, as of the last call to
+ * predict. Inactive bodies reach no further than their radius.
+ */
+float
+BodyStore::getMaxActiveReach() const {
+	return mMaxActiveReach;
+}
+
+/**
+ * Sets the offset of every active body to the distance it moves at its
+ * current speed, and its reach to include that offset.
+ *
+ * @param seconds Duration of the next step.
+ */
+void
+BodyStore::predict(float seconds) {
+	// On local pointers, so that the compiler can vectorize this loop.
+	const size_t count = mActiveCount;
+	const float* speedsX = mSpeedX.data();
+	const float* speedsY = mSpeedY.data();
+	const float* radii = mRadius.data();
+	float* offsetsX = mOffsetX.data();
+	float* offsetsY = mOffsetY.data();
+	float* reaches = mReach.data();
+	for (size_t i = 0; i < count; i++) {
+		offsetsX[i] = speedsX[i] * seconds;
+		offsetsY[i] = speedsY[i] * seconds;
+	}
+	// Reach is tested on each axis on its own, so the larger component of
+	// the offset is enough.
+	for (size_t i = 0; i < count; i++)
+		reaches[i] = radii[i] + std::max(std::abs(offsetsX[i]),
+				std::abs(offsetsY[i]));
+	float maxReach = 0;
+	for (size_t i = 0; i < count; i++)
+		maxReach = std::max(maxReach, reaches[i]);
+	mMaxActiveReach = maxReach;
+}
+
+/**
+ * Moves every active body by its offset.
+ */
+void
+BodyStore::integrate() {
+	const size_t count = mActiveCount;
+	const float* offsetsX = mOffsetX.data();
+	const float* offsetsY = mOffsetY.data();
+	float* xs = mX.data();
+	float* ys = mY.data();
+	for (size_t i = 0; i < count; i++) {
+		xs[i] += offsetsX[i];
+		ys[i] += offsetsY[i];
+	}
+}
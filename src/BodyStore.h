@@ -0,0 +1,82 @@
+/*
+ * BodyStore.h
+ *
+ *  Created on: 19.10.2026
+ */
+
+#ifndef DG_BODYSTORE_H_
+#define DG_BODYSTORE_H_
+
+#include <memory>
+#include <vector>
+
+#include "util/Vector.h"
+
+class Sprite;
+
+/**
+ * Position, speed and collision filter of all sprites in a World, kept in
+ * one array per value so that movement runs over contiguous memory and can
+ * be vectorized.
+ *
+ * While a sprite is inserted, the store owns these values and the sprite
+ * reads and writes them through its slot. They are copied back into the
+ * sprite when it is removed.
+ *
+ * Bodies that are moving are kept at the front of the arrays by activate
+ * and deactivate, so that a step only visits those. A step is split into
+ * predict, which sets each offset from the speed, collision tests that
+ * shorten offsets through getOffset and setOffset, and integrate, which
+ * adds the offsets to the positions. Inactive bodies always have a zero
+ * offset.
+ */
+class BodyStore {
+public:
+	~BodyStore();
+	void insert(std::shared_ptr<Sprite> sprite);
+	void remove(Sprite& sprite);
+	void activate(Sprite& sprite);
+	void deactivate(Sprite& sprite);
+	size_t getCount() const;
+	size_t getActiveCount() const;
+	Vector2f getPosition(const Sprite& sprite) const;
+	void setPosition(const Sprite& sprite, const Vector2f& position);
+	Vector2f getSpeed(const Sprite& sprite) const;
+	void setSpeed(const Sprite& sprite, const Vector2f& speed);
+	unsigned short getMask(const Sprite& sprite) const;
+	void setMask(const Sprite& sprite, unsigned short mask);
+	Vector2f getOffset(const Sprite& sprite) const;
+	void setOffset(const Sprite& sprite, const Vector2f& offset);
+	float getReach(const Sprite& sprite) const;
+	float getMaxActiveReach() const;
+	void predict(float seconds);
+	void integrate();
+
+private:
+	void detach(Sprite& sprite);
+	void swap(size_t first, size_t second);
+
+private:
+	std::vector<float> mX;
+	std::vector<float> mY;
+	/// Movement per second.
+	std::vector<float> mSpeedX;
+	std::vector<float> mSpeedY;
+	/// Movement within the current step, set by predict.
+	std::vector<float> mOffsetX;
+	std::vector<float> mOffsetY;
+	/// Distance from center to the furthest corner, regardless of rotation.
+	std::vector<float> mRadius;
+	/// Radius plus the larger component of the offset.
+	std::vector<float> mReach;
+	std::vector<unsigned short> mCategory;
+	std::vector<unsigned short> mMask;
+	/// Owner of each slot, which stores its index in Sprite::mSlot.
+	std::vector<std::shared_ptr<Sprite> > mSprites;
+	/// Number of active bodies, which are in the slots before all others.
+	size_t mActiveCount = 0;
+	/// Largest reach of any active body, set by predict.
+	float mMaxActiveReach = 0;
+};
+
+#endif /* DG_BODYSTORE_H_ */
@@ -0,0 +1,189 @@
+/*
+ * BulletSystem.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "BulletSystem.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <Thor/Vectors.hpp>
+
+const ConfigFields<BulletConfig>&
+BulletConfig::getFields() {
+	static const ConfigFields<BulletConfig> fields = ConfigFields<BulletConfig>()
+			.add("size", &BulletConfig::size)
+			.addTexture("texture", &BulletConfig::texture);
+	return fields;
+}
+
+/**
+ * Adds a new bullet at the end of the arrays.
+ */
+void
+BulletSystem::insert(const Bullet& bullet) {
+	mX.push_back(bullet.position.x);
+	mY.push_back(bullet.position.y);
+	mSpeedX.push_back(bullet.speed.x);
+	mSpeedY.push_back(bullet.speed.y);
+	mStartX.push_back(bullet.position.x);
+	mStartY.push_back(bullet.position.y);
+	mMaxRangeSquared.push_back((bullet.maxRange == 0)
+			? std::numeric_limits<float>::max()
+			: bullet.maxRange * bullet.maxRange);
+	mHalfWidth.push_back(bullet.size.x / 2.0f);
+	mHalfHeight.push_back(bullet.size.y / 2.0f);
+	mDirection.push_back((bullet.speed != Vector2f())
+			? thor::unitVector(bullet.speed)
+			: Vector2f(0, -1));
+	mTexture.push_back(bullet.texture);
+	mDamage.push_back(bullet.damage);
+	mShooterId.push_back(bullet.shooterId);
+	mAlive.push_back(true);
+}
+
+/**
+ * Moves all bullets and kills those that exceeded their range.
+ *
+ * @param seconds Time since the last call.
+ */
+void
+BulletSystem::integrate(float seconds) {
+	// Local pointers, so that the compiler can vectorize these loops.
+	const size_t count = mX.size();
+	float* x = mX.data();
+	float* y = mY.data();
+	const float* speedX = mSpeedX.data();
+	const float* speedY = mSpeedY.data();
+	const float* startX = mStartX.data();
+	const float* startY = mStartY.data();
+	const float* maxRangeSquared = mMaxRangeSquared.data();
+	char* alive = mAlive.data();
+	for (size_t i = 0; i < count; i++) {
+		x[i] += speedX[i] * seconds;
+		y[i] += speedY[i] * seconds;
+	}
+	for (size_t i = 0; i < count; i++) {
+		float dx = x[i] - startX[i];
+		float dy = y[i] - startY[i];
+		alive[i] &= dx * dx + dy * dy < maxRangeSquared[i];
+	}
+}
+
+/**
+ * Removes all dead bullets, keeping the order of the others.
+ */
+void
+BulletSystem::removeDead() {
+	size_t count = 0;
+	for (size_t i = 0; i < mX.size(); i++) {
+		if (!mAlive[i])
+			continue;
+		mX[count] = mX[i];
+		mY[count] = mY[i];
+		mSpeedX[count] = mSpeedX[i];
+		mSpeedY[count] = mSpeedY[i];
+		mStartX[count] = mStartX[i];
+		mStartY[count] = mStartY[i];
+		mMaxRangeSquared[count] = mMaxRangeSquared[i];
+		mHalfWidth[count] = mHalfWidth[i];
+		mHalfHeight[count] = mHalfHeight[i];
+		mDirection[count] = mDirection[i];
+		mTexture[count] = mTexture[i];
+		mDamage[count] = mDamage[i];
+		mShooterId[count] = mShooterId[i];
+		mAlive[count] = true;
+		count++;
+	}
+	mX.resize(count);
+	mY.resize(count);
+	mSpeedX.resize(count);
+	mSpeedY.resize(count);
+	mStartX.resize(count);
+	mStartY.resize(count);
+	mMaxRangeSquared.resize(count);
+	mHalfWidth.resize(count);
+	mHalfHeight.resize(count);
+	mDirection.resize(count);
+	mTexture.resize(count);
+	mDamage.resize(count);
+	mShooterId.resize(count);
+	mAlive.resize(count);
+}
+
+/**
+ * Marks a bullet to be removed by the next call to removeDead.
+ */
+void
+BulletSystem::kill(size_t index) {
+	mAlive[index] = false;
+}
+
+/**
+ * Returns the number of bullets, including dead ones.
+ */
+size_t
+BulletSystem::getCount() const {
+	return mX.size();
+}
+
+bool
+BulletSystem::isAlive(size_t index) const {
+	return mAlive[index];
+}
+
+Vector2f
+BulletSystem::getPosition(size_t index) const {
+	return Vector2f(mX[index], mY[index]);
+}
+
+/**
+ * Returns the radius used for collisions, same as Circle::getRadius.
+ */
+float
+BulletSystem::getRadius(size_t index) const {
+	return mHalfWidth[index];
+}
+
+int
+BulletSystem::getDamage(size_t index) const {
+	return mDamage[index];
+}
+
+unsigned int
+BulletSystem::getShooterId(size_t index) const {
+	return mShooterId[index];
+}
+
+/**
+ * Appends a quad for every living bullet that intersects screen, rotated in
+ * movement direction.
+ */
+void
+BulletSystem::appendQuads(sf::VertexArray& vertices,
+		const sf::FloatRect& screen) const {
+	for (size_t i = 0; i < mX.size(); i++) {
+		float extent = std::max(mHalfWidth[i], mHalfHeight[i]);
+		if (!mAlive[i] || !screen.intersects(sf::FloatRect(mX[i] - extent,
+				mY[i] - extent, 2 * extent, 2 * extent)))
+			continue;
+		// Rotates local coordinates so that (0, -1) points in direction.
+		const Vector2f& d = mDirection[i];
+		auto corner = [&](float x, float y) {
+			return Vector2f(mX[i] - d.y * x - d.x * y, mY[i] + d.x * x - d.y * y);
+		};
+		const sf::IntRect& t = mTexture[i];
+		float hw = mHalfWidth[i];
+		float hh = mHalfHeight[i];
+		vertices.append(sf::Vertex(corner(-hw, -hh),
+				Vector2f(t.left, t.top)));
+		vertices.append(sf::Vertex(corner(hw, -hh),
+				Vector2f(t.left + t.width, t.top)));
+		vertices.append(sf::Vertex(corner(hw, hh),
+				Vector2f(t.left + t.width, t.top + t.height)));
+		vertices.append(sf::Vertex(corner(-hw, hh),
+				Vector2f(t.left, t.top + t.height)));
+	}
+}
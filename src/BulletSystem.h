@@ -0,0 +1,90 @@
+/*
+ * BulletSystem.h
+ *
+ *  Created on: 19.10.2026
+ */
+
+#ifndef DG_BULLETSYSTEM_H_
+#define DG_BULLETSYSTEM_H_
+
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include "util/Config.h"
+#include "util/Vector.h"
+
+/**
+ * Appearance of a bullet type, read from a bullet YAML file.
+ */
+struct BulletConfig {
+	/// Size of the textured quad, the collision radius is half its width.
+	Vector2f size;
+	Loader::ResourceId texture;
+
+	static const ConfigFields<BulletConfig>& getFields();
+};
+
+/**
+ * Stores all bullets in a World, with one array per value.
+ *
+ * Bullets fly in a straight line until they hit something or exceed their
+ * range. Movement and range checks are done for all bullets at once in
+ * loops the compiler can vectorize, collisions are tested by World.
+ */
+class BulletSystem {
+public:
+	/**
+	 * Values needed to create a bullet.
+	 */
+	struct Bullet {
+		Vector2f position;
+		/// Movement per second.
+		Vector2f speed;
+		/// Size of the textured quad, the collision radius is half its width.
+		Vector2f size;
+		/// Texture coordinates of the quad.
+		sf::IntRect texture;
+		int damage;
+		/// Zero for unlimited range.
+		float maxRange;
+		/// Sprite id of the character that this bullet never hits.
+		unsigned int shooterId;
+	};
+
+public:
+	void insert(const Bullet& bullet);
+	void integrate(float seconds);
+	void removeDead();
+	void kill(size_t index);
+	size_t getCount() const;
+	bool isAlive(size_t index) const;
+	Vector2f getPosition(size_t index) const;
+	float getRadius(size_t index) const;
+	int getDamage(size_t index) const;
+	unsigned int getShooterId(size_t index) const;
+	void appendQuads(sf::VertexArray& vertices,
+			const sf::FloatRect& screen) const;
+
+private:
+	std::vector<float> mX;
+	std::vector<float> mY;
+	std::vector<float> mSpeedX;
+	std::vector<float> mSpeedY;
+	std::vector<float> mStartX;
+	std::vector<float> mStartY;
+	std::vector<float> mMaxRangeSquared;
+	std::vector<float> mHalfWidth;
+	std::vector<float> mHalfHeight;
+	/// Unit vector of the movement direction.
+	std::vector<Vector2f> mDirection;
+	std::vector<sf::IntRect> mTexture;
+	std::vector<int> mDamage;
+	/// Sprite id of the shooter, which stays valid after it is destroyed.
+	std::vector<unsigned int> mShooterId;
+	/// False once a bullet hit something or exceeded its range.
+	std::vector<char> mAlive;
+};
+
+#endif /* DG_BULLETSYSTEM_H_ */
@@ -7,6 +7,8 @@
 
 #include "Game.h"
 
+#include <sstream>
+
 #include <Thor/Vectors.hpp>
 
 #include <LTBL/Utils.h>
@@ -16,7 +18,11 @@
 #include "sprites/Player.h"
 #include "sprites/items/HealthOrb.h"
 #include "util/Angles.h"
+#include "util/ConfigWatcher.h"
 #include "util/Loader.h"
+#include "util/Log.h"
+#include "util/Profiler.h"
+#include "util/Trace.h"
 #include "util/Yaml.h"
 
 /**
@@ -27,7 +33,7 @@ Game::Game(tgui::Window& window) :
 		mWorldView(Vector2f(0, 0), mWindow.getView().getSize()),
 		mLightSystem(AABB(Vec2f(-100000, -100000), Vec2f(100000, 10000)), &window,
 				"res/textures/light_fin.png", "res/shaders/light_attenuation_shader.frag"),
-		mGenerator(mWorld, mPathfinder, mLightSystem, Yaml("generation.yaml")) {
+		mGenerator(mWorld, mPathfinder, mLightSystem) {
 	mWindow.setFramerateLimit(FPS_GOAL);
 	mWindow.setKeyRepeatEnabled(false);
 	srand(time(nullptr));
@@ -50,7 +56,10 @@ Game::Game(tgui::Window& window) :
 	mRightGadget = window.add<tgui::Label>();
 	mRightGadget->setTextSize(14);
 	mPickupInstruction = window.add<tgui::Label>();
-	mPickupInstruction->setTextSize(14);
+	mPickupInstruction->setTextSize(14);
+	mProfile = window.add<tgui::Label>();
+	mProfile->setTextSize(12);
+	mProfile->hide();
 }
 
 /**
@@ -129,28 +138,47 @@ Game::initLight() {
 void
 Game::loop() {
 	while (!mQuit) {
+		ConfigWatcher::i().update();
+		Loader::i().update();
 		input();
 
 		int elapsed = (mPaused)
 				? 0
 				: mClock.restart().asMilliseconds();
-
-		mWorld.think(elapsed);
-		// Respawn player at start position on death.
-		if (mPlayer->getHealth() <= 0) {
-			Vector2f pos = mPlayer->getCrosshairPosition();
-			initPlayer();
-			mPlayer->setCrosshairPosition(pos);
+		Trace::i().nextFrame(elapsed);
+
+		{
+			ProfileZone zone("Game::think");
+			mWorld.think(elapsed);
+			// Respawn player at start position on death.
+			if (mPlayer->getHealth() <= 0) {
+				Vector2f pos = mPlayer->getCrosshairPosition();
+				initPlayer();
+				mPlayer->setCrosshairPosition(pos);
+			}
 		}
 
-		mWorld.step(elapsed);
+		{
+			ProfileZone zone("Game::step");
+			mWorld.step(elapsed);
+		}
 
-		updateGui();
+		{
+			ProfileZone zone("Game::updateGui");
+			updateGui();
+		}
 
-		render();
+		{
+			ProfileZone zone("Game::render");
+			render();
+		}
 
-		auto enemySpawns = mGenerator.generateCurrentAreaIfNeeded(mPlayer->getPosition());
-		insertEnemies(enemySpawns);
+		{
+			ProfileZone zone("Game::generate");
+			auto enemySpawns = mGenerator.generateCurrentAreaIfNeeded(mPlayer->getPosition());
+			insertEnemies(enemySpawns);
+		}
+		Profiler::i().nextFrame();
 	}
 }
 
@@ -195,6 +223,32 @@ Game::updateGui() {
 	}
 	else
 		mPickupInstruction->hide();
+
+	if (Profiler::isEnabled())
+		updateProfile();
+}
+
+/**
+ * Shows the average time per frame of each profiler zone, and resource
+ * statistics.
+ */
+void
+Game::updateProfile() {
+	std::ostringstream text;
+	text.setf(std::ios::fixed);
+	text.precision(2);
+	for (const auto& zone : Profiler::i().getStats())
+		text << zone.name << ": " << zone.milliseconds << " ms, "
+				<< zone.calls << " calls\n";
+	Loader::Stats loader = Loader::i().getStats();
+	text << "Draw calls: " << mWorld.getDrawCalls() << "\n"
+			<< "Textures: " << loader.resident << " loaded ("
+			<< loader.residentBytes / 1024 << " KiB), " << loader.hits
+			<< " hits, " << loader.misses << " misses\n"
+			<< "Configs: " << Yaml::getParseCount() << " parsed, "
+			<< Yaml::getCacheHitCount() << " cache hits";
+	mProfile->setText(text.str());
+	mProfile->setPosition(0, 0);
 }
 
 /**
@@ -259,6 +313,19 @@ Game::keyUp(const sf::Event& event) {
 	case sf::Keyboard::F:
 		mPlayer->pickUpItem();
 		break;
+	case sf::Keyboard::F3:
+		Profiler::i().setEnabled(!Profiler::isEnabled());
+		if (Profiler::isEnabled())
+			mProfile->show();
+		else
+			mProfile->hide();
+		break;
+	case sf::Keyboard::F4:
+		if (Profiler::i().exportChromeTrace("profile.json"))
+			LOG_I("Wrote profile.json");
+		else
+			LOG_W("Failed to write profile.json");
+		break;
 	default:
 		break;
 	}
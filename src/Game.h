@@ -41,6 +41,7 @@ private:
 
 	Vector2<float> convertCoordinates(int x, int y);
 	void updateGui();
+	void updateProfile();
 	void initPlayer();
 	void initLight();
 	void insertEnemies(const std::vector<Vector2f>& positions);
@@ -57,6 +58,8 @@ private:
 	tgui::Label* mLeftGadget;
 	tgui::Label* mRightGadget;
 	tgui::Label* mPickupInstruction;
+	/// Profiler averages, shown while profiling is enabled.
+	tgui::Label* mProfile;
 	std::shared_ptr<sf::Texture> mCrosshairTexture;
 	sf::Sprite mCrosshair;
 
@@ -14,6 +14,8 @@
 #include <Thor/Vectors.hpp>
 
 #include "util/Interval.h"
+#include "util/Profiler.h"
+#include "util/Trace.h"
 #include "sprites/Tile.h"
 
 /**
@@ -92,6 +94,22 @@ Pathfinder::astarArea(Area* start, Area* end) const {
 std::vector<Vector2f>
 Pathfinder::getPath(const Vector2f& start, const Vector2f& end,
 		float radius) const {
+	ProfileZone zone("Pathfinder::getPath");
+	if (!Trace::isEnabled())
+		return findPath(start, end, radius);
+	sf::Clock clock;
+	std::vector<Vector2f> path = findPath(start, end, radius);
+	Trace::record(Trace::PATH, path.size(), 0,
+			clock.getElapsedTime().asMicroseconds(), thor::length(end - start));
+	return path;
+}
+
+/**
+ * Implements getPath.
+ */
+std::vector<Vector2f>
+Pathfinder::findPath(const Vector2f& start, const Vector2f& end,
+		float radius) const {
 	if (!getArea(end))
 		return std::vector<Vector2f>();
 	std::vector<Portal*> portals = astarArea(getArea(start), getArea(end));
@@ -142,6 +160,7 @@ Pathfinder::getPath(const Vector2f& start, const Vector2f& end,
 void
 Pathfinder::insertArea(const sf::FloatRect& rect) {
 	Area a;
+	a.tiles = sf::IntRect(rect);
 	a.area = sf::FloatRect(rect.left * Tile::TILE_SIZE.x  - Tile::TILE_SIZE.x / 2.0f,
 			rect.top * Tile::TILE_SIZE.y - Tile::TILE_SIZE.y / 2.0f,
 			rect.width * Tile::TILE_SIZE.x,
@@ -151,6 +170,28 @@ Pathfinder::insertArea(const sf::FloatRect& rect) {
 	mAreas.push_back(a);
 }
 
+/**
+ * Removes all areas that overlap rect.
+ *
+ * @warning Portals are invalid until generatePortals is called.
+ *
+ * @param rect Rectangle in tile coordinates.
+ * @return The removed areas, in tile coordinates.
+ */
+std::vector<sf::IntRect>
+Pathfinder::removeAreas(const sf::IntRect& rect) {
+	std::vector<sf::IntRect> removed;
+	auto overlaps = [&rect](const Area& a) {
+		return a.tiles.intersects(rect);
+	};
+	for (const auto& a : mAreas)
+		if (overlaps(a))
+			removed.push_back(a.tiles);
+	mAreas.erase(std::remove_if(mAreas.begin(), mAreas.end(), overlaps),
+			mAreas.end());
+	return removed;
+}
+
 /**
  * Generates portals that connect areas. Needs to be run after insertArea for
  * path finding to work.
@@ -26,6 +26,7 @@ private:
 
 public:
 	void insertArea(const sf::FloatRect& rect);
+	std::vector<sf::IntRect> removeAreas(const sf::IntRect& rect);
 	void generatePortals();
 	std::vector<Vector2f> getPath(const Vector2f& start,
 			const Vector2f& end, float radius) const;
@@ -33,6 +34,8 @@ public:
 private:
     Area* getArea(const Vector2f& point) const;
     std::vector<Portal*> astarArea(Area* start, Area* end) const;
+	std::vector<Vector2f> findPath(const Vector2f& start, const Vector2f& end,
+			float radius) const;
 	void draw(sf::RenderTarget& target, sf::RenderStates states) const;
 
 private:
@@ -58,6 +61,7 @@ struct Pathfinder::Portal {
  * Nodes
  */
 struct Pathfinder::Area {
+	sf::IntRect tiles;
 	sf::FloatRect area;
 	Vector2f center;
 	std::vector<Portal> portals;
@@ -7,11 +7,41 @@
 
 #include "World.h"
 
+#include <tuple>
+
 #include <Thor/Vectors.hpp>
 
 #include "sprites/Tile.h"
+#include "sprites/abstract/Circle.h"
 #include "util/Interval.h"
 #include "util/Log.h"
+#include "util/Profiler.h"
+#include "util/Trace.h"
+#include "util/Yaml.h"
+
+/**
+ * Packs the textures returned by getAtlasFiles into the atlas used for
+ * drawing.
+ */
+World::World() :
+		mAtlas(getAtlasFiles()) {
+	for (auto type : {Tile::Type::FLOOR, Tile::Type::WALL})
+		mTileTextures[type] = mAtlas.getRect(
+				Loader::i().getId<sf::Texture>(Tile::getTexture(type)));
+}
+
+/**
+ * Returns the textures listed in textures.yaml and those of all tile types,
+ * which are drawn from a single texture.
+ */
+std::vector<std::string>
+World::getAtlasFiles() {
+	std::vector<std::string> textures = Yaml("textures.yaml")
+			.get("atlas", std::vector<std::string>());
+	textures.push_back(Tile::getTexture(Tile::Type::FLOOR));
+	textures.push_back(Tile::getTexture(Tile::Type::WALL));
+	return textures;
+}
 
 /**
  * Insert a drawable into the group. Drawables should only be handled with shared_ptr.
@@ -25,6 +55,28 @@ World::insert(std::shared_ptr<Sprite> drawable) {
 	assert(item == mDrawables[cat].end());
 #endif
 	mDrawables[drawable->getCategory()].push_back(drawable);
+	mBodies.insert(drawable);
+	insertIntoCell(drawable.get(),
+			{toSpriteCell(drawable->getPosition()), mSpriteInsertions++});
+	mMaxSpriteExtent = std::max(mMaxSpriteExtent,
+			thor::length(drawable->getHalfSize()));
+	drawable->mContainingWorld = this;
+	if (drawable->getSpeed() != Vector2f() || drawable->getDelete())
+		wake(*drawable);
+}
+
+/**
+ * Adds sprite to the sprites visited by step, if it is not there already.
+ * Called by Sprite when it starts moving or is marked for deletion, step
+ * removes it again once it stopped.
+ */
+void
+World::wake(Sprite& sprite) {
+	if (sprite.mActive)
+		return;
+	sprite.mActive = true;
+	mActiveSprites.push_back(sprite.shared_from_this());
+	mBodies.activate(sprite);
 }
 
 /**
@@ -41,11 +93,184 @@ World::insertCharacter(std::shared_ptr<Character> character) {
 	insert(character);
 }
 
+/**
+ * Inserts a bullet into the world. Bullets fly straight until they hit a
+ * wall, a character or anything else that collides with particles.
+ *
+ * @param shooter Character that is never hit by this bullet.
+ * @param direction Movement direction, does not have to be normalized.
+ * @param config Texture and size of the bullet.
+ * @param speed Movement speed in pixels per second.
+ * @param damage Damage dealt to a character that is hit.
+ * @param maxRange Distance after which the bullet disappears, zero for
+ * 				   unlimited range.
+ */
+void
+World::insertBullet(const Vector2f& position, const Character& shooter,
+		const Vector2f& direction, const BulletConfig& config, float speed,
+		int damage, float maxRange) {
+	BulletSystem::Bullet bullet;
+	bullet.position = position;
+	bullet.speed = direction;
+	if (direction != Vector2f())
+		thor::setLength(bullet.speed, speed);
+	bullet.size = config.size;
+	// Same as the texture rect set in Sprite, but limited to the image.
+	bullet.texture = mAtlas.getRect(config.texture);
+	bullet.texture.width = std::min(bullet.texture.width, (int) bullet.size.x);
+	bullet.texture.height = std::min(bullet.texture.height, (int) bullet.size.y);
+	bullet.damage = damage;
+	bullet.maxRange = maxRange;
+	bullet.shooterId = shooter.getId();
+	mBullets.insert(bullet);
+}
+
+/**
+ * Inserts a tile into the world, and into the index used by getTile. There
+ * must not be another tile at the same position.
+ *
+ * Tiles are drawn from the vertices of their chunk instead of Sprite::draw.
+ */
+void
+World::insertTile(std::shared_ptr<Tile> tile) {
+	std::shared_ptr<Tile>& stored = mTileChunks[toTileChunk(tile->getTilePosition())]
+			.tiles[toTileIndex(tile->getTilePosition())];
+	assert(!stored);
+	stored = tile;
+	mDrawables[tile->getCategory()].push_back(tile);
+	mBodies.insert(tile);
+	tile->mContainingWorld = this;
+	updateTile(*tile);
+}
+
 void
 World::remove(std::shared_ptr<Sprite> drawable) {
 	Sprite::Category cat = drawable->getCategory();
 	auto item = std::find(mDrawables[cat].begin(), mDrawables[cat].end(), drawable);
 	mDrawables[cat].erase(item);
+	mBodies.remove(*drawable);
+	removeFromCell(drawable.get());
+	drawable->mContainingWorld = nullptr;
+	if (drawable->mActive) {
+		drawable->mActive = false;
+		mActiveSprites.erase(std::find(mActiveSprites.begin(),
+				mActiveSprites.end(), drawable));
+	}
+
+	if (cat == Sprite::CATEGORY_WORLD) {
+		auto tile = std::dynamic_pointer_cast<Tile>(drawable);
+		if (tile && getTile(tile->getTilePosition()) == tile) {
+			TileChunk& chunk = mTileChunks[toTileChunk(tile->getTilePosition())];
+			int index = toTileIndex(tile->getTilePosition());
+			chunk.tiles[index].reset();
+			std::fill(&chunk.vertices[4 * index], &chunk.vertices[4 * index] + 4,
+					sf::Vertex());
+		}
+	}
+}
+
+/**
+ * Updates the quad used to draw tile, must be called whenever the tile's
+ * type changes.
+ */
+void
+World::updateTile(const Tile& tile) {
+	sf::Vertex* quad = &mTileChunks[toTileChunk(tile.getTilePosition())]
+			.vertices[4 * toTileIndex(tile.getTilePosition())];
+	Vector2f topLeft = tile.getPosition() - tile.getHalfSize();
+	Vector2f bottomRight = tile.getPosition() + tile.getHalfSize();
+	sf::FloatRect texture(mTileTextures.at(tile.getType()));
+	quad[0].position = Vector2f(topLeft.x, topLeft.y);
+	quad[1].position = Vector2f(bottomRight.x, topLeft.y);
+	quad[2].position = Vector2f(bottomRight.x, bottomRight.y);
+	quad[3].position = Vector2f(topLeft.x, bottomRight.y);
+	quad[0].texCoords = Vector2f(texture.left, texture.top);
+	quad[1].texCoords = Vector2f(texture.left + texture.width, texture.top);
+	quad[2].texCoords = Vector2f(texture.left + texture.width,
+			texture.top + texture.height);
+	quad[3].texCoords = Vector2f(texture.left, texture.top + texture.height);
+}
+
+/**
+ * Returns the tile at position (in tile coordinates), or null if no tile
+ * was inserted there via insertTile.
+ */
+std::shared_ptr<Tile>
+World::getTile(const Vector2i& position) const {
+	auto chunk = mTileChunks.find(toTileChunk(position));
+	return (chunk != mTileChunks.end())
+			? chunk->second.tiles[toTileIndex(position)]
+			: std::shared_ptr<Tile>();
+}
+
+/**
+ * Adds sprite to the cell and index entry given by cell.
+ */
+void
+World::insertIntoCell(Sprite* sprite, const SpriteCell& cell) {
+	mSpriteCells[cell.cell].push_back(sprite);
+	mSpriteIndex[sprite] = cell;
+}
+
+/**
+ * Removes sprite from mSpriteCells, if it is stored there.
+ */
+void
+World::removeFromCell(Sprite* sprite) {
+	auto index = mSpriteIndex.find(sprite);
+	if (index == mSpriteIndex.end())
+		return;
+	std::vector<Sprite*>& cell = mSpriteCells[index->second.cell];
+	cell.erase(std::find(cell.begin(), cell.end(), sprite));
+	if (cell.empty())
+		mSpriteCells.erase(index->second.cell);
+	mSpriteIndex.erase(index);
+}
+
+/**
+ * Moves sprite to another cell if its position has changed to outside of
+ * its current cell.
+ */
+void
+World::updateCell(Sprite* sprite) {
+	auto index = mSpriteIndex.find(sprite);
+	Vector2i cell = toSpriteCell(sprite->getPosition());
+	if (index == mSpriteIndex.end() || index->second.cell == cell)
+		return;
+	SpriteCell moved = {cell, index->second.order};
+	removeFromCell(sprite);
+	insertIntoCell(sprite, moved);
+}
+
+/**
+ * Returns the cell in mSpriteCells that contains position.
+ */
+Vector2i
+World::toSpriteCell(const Vector2f& position) {
+	return Vector2i(std::floor(position.x / SPRITE_CELL_SIZE),
+			std::floor(position.y / SPRITE_CELL_SIZE));
+}
+
+/**
+ * Returns the position of the chunk containing the tile at position.
+ */
+Vector2i
+World::toTileChunk(const Vector2i& position) {
+	auto divide = [](int value) {
+		return (value >= 0)
+				? value / TILE_CHUNK_SIZE
+				: (value - TILE_CHUNK_SIZE + 1) / TILE_CHUNK_SIZE;
+	};
+	return Vector2i(divide(position.x), divide(position.y));
+}
+
+/**
+ * Returns the index of the tile at position within its chunk.
+ */
+int
+World::toTileIndex(const Vector2i& position) {
+	Vector2i offset = position - toTileChunk(position) * TILE_CHUNK_SIZE;
+	return offset.y * TILE_CHUNK_SIZE + offset.x;
 }
 
 /**
@@ -68,49 +293,248 @@ World::getCharacters(const Vector2f& position, float maxDistance) const {
  * Checks for collisions and applies movement, also removes sprites if
  * Sprite::getDelete returns true.
  *
+ * Only active sprites are visited, sprites that stopped moving are removed
+ * from mActiveSprites until Sprite wakes them again.
+ *
+ * Movement is computed for all active bodies at once by BodyStore::predict,
+ * then shortened by collisions of each active sprite and applied by
+ * BodyStore::integrate. Collisions are tested against the movement of the
+ * other sprite within the same step, which is already shortened if that
+ * sprite was visited before.
+ *
  * This method can be improved by only testing each pair of sprites once,
- * and using the result for both. Applying movement should be done in
- * testCollision, always applying the part that causes no collision.
+ * and using the result for both.
  */
 void
 World::step(int elapsed) {
-	for (auto v = mDrawables.begin(); v != mDrawables.end(); v++) {
-		for (auto it = v->second.begin(); it != v->second.end(); ) {
-			if ((*it)->getDelete() && (*it)->getCategory() != Character::CATEGORY_ACTOR)
-				it = v->second.erase(it);
-			else {
-				// Don't run collision tests if sprite is not moving.
-				if ((*it)->getSpeed() != Vector2f())
-					applyMovement(*it, elapsed);
-				it++;
-			}
+	for (size_t i = 0; i < mActiveSprites.size(); ) {
+		std::shared_ptr<Sprite> sprite = mActiveSprites[i];
+		if (sprite->getDelete() && sprite->getCategory() != Character::CATEGORY_ACTOR) {
+			// Also removes sprite from mActiveSprites.
+			remove(sprite);
+		}
+		else if (sprite->getSpeed() != Vector2f())
+			i++;
+		else {
+			sprite->mActive = false;
+			mActiveSprites.erase(mActiveSprites.begin() + i);
+			mBodies.deactivate(*sprite);
 		}
 	}
+
+	mBodies.predict(elapsed / 1000.0f);
+	std::vector<std::shared_ptr<Sprite> > candidates;
+	// Callbacks may wake sprites, which are only moved from the next step.
+	size_t moving = mActiveSprites.size();
+	for (size_t i = 0; i < moving; i++)
+		resolveCollisions(mActiveSprites[i], candidates);
+	mBodies.integrate();
+	for (const auto& sprite : mActiveSprites)
+		updateCell(sprite.get());
+	stepBullets(elapsed);
 }
 
 /**
- * Tests spriteA for overlap with every other sprite (considering collision
- * masks).
+ * Moves all bullets, applies damage to characters that were hit and removes
+ * bullets that hit something or exceeded their range.
  */
 void
-World::applyMovement(std::shared_ptr<Sprite> sprite, int elapsed) {
-	Vector2f offset = sprite->getSpeed() * (elapsed / 1000.0f);
-	for (auto w = mDrawables.begin(); w != mDrawables.end(); w++) {
-		for (const auto& other : w->second) {
-			if (sprite == other)
-				continue;
-			// Ignore anything that is filtered by masks.
-			if (!sprite->collisionEnabled(other->getCategory()) ||
-					!other->collisionEnabled(sprite->getCategory()))
+World::stepBullets(int elapsed) {
+	mBullets.integrate(elapsed / 1000.0f);
+	// Damage is applied afterwards, as it may insert or remove sprites.
+	std::vector<std::pair<Character*, int> > damaged;
+	for (size_t i = 0; i < mBullets.getCount(); i++) {
+		if (!mBullets.isAlive(i))
+			continue;
+		Vector2f position = mBullets.getPosition(i);
+		if (bulletHitsTile(position, mBullets.getRadius(i))) {
+			Trace::record(Trace::BULLET_HIT, mBullets.getShooterId(i), 0,
+					position.x, position.y);
+			mBullets.kill(i);
+			continue;
+		}
+		Sprite* hit = getBulletHit(i);
+		if (hit == nullptr)
+			continue;
+		Trace::record(Trace::BULLET_HIT, mBullets.getShooterId(i), hit->getId(),
+				position.x, position.y);
+		if (hit->getCategory() == Sprite::CATEGORY_ACTOR)
+			damaged.push_back(std::make_pair(static_cast<Character*>(hit),
+					mBullets.getDamage(i)));
+		mBullets.kill(i);
+	}
+	mBullets.removeDead();
+	for (const auto& d : damaged)
+		d.first->onDamage(d.second);
+}
+
+namespace {
+
+/**
+ * Returns true if a circle intersects a rectangle that is rotated so that
+ * (0, -1) points in direction.
+ */
+bool
+circleHitsRect(const Vector2f& center, float radius,
+		const Vector2f& rectCenter, const Vector2f& halfSize,
+		const Vector2f& direction) {
+	Vector2f offset = center - rectCenter;
+	// Inverse of the rotation from (0, -1) to direction.
+	Vector2f local(-direction.y * offset.x + direction.x * offset.y,
+			-direction.x * offset.x - direction.y * offset.y);
+	Vector2f closest(std::max(- halfSize.x, std::min(halfSize.x, local.x)),
+			std::max(- halfSize.y, std::min(halfSize.y, local.y)));
+	return thor::squaredLength(local - closest) < radius * radius;
+}
+
+}
+
+/**
+ * Returns true if a circle at position intersects a solid tile.
+ */
+bool
+World::bulletHitsTile(const Vector2f& position, float radius) const {
+	// Tile positions are the tile centers.
+	Vector2f halfTile = Vector2f(Tile::TILE_SIZE) / 2.0f;
+	Vector2i first(std::floor((position.x - radius + halfTile.x) / Tile::TILE_SIZE.x),
+			std::floor((position.y - radius + halfTile.y) / Tile::TILE_SIZE.y));
+	Vector2i last(std::floor((position.x + radius + halfTile.x) / Tile::TILE_SIZE.x),
+			std::floor((position.y + radius + halfTile.y) / Tile::TILE_SIZE.y));
+	for (int x = first.x; x <= last.x; x++)
+		for (int y = first.y; y <= last.y; y++) {
+			std::shared_ptr<Tile> tile = getTile(Vector2i(x, y));
+			if (tile && tile->collisionEnabled(Sprite::CATEGORY_PARTICLE) &&
+					circleHitsRect(position, radius, tile->getPosition(),
+							tile->getHalfSize(), Vector2f(0, -1)))
+				return true;
+		}
+	return false;
+}
+
+/**
+ * Returns the sprite (other than a tile) that the bullet at index hits, or
+ * null. If multiple sprites are hit, the one with the lowest category is
+ * returned.
+ */
+Sprite*
+World::getBulletHit(size_t bullet) const {
+	Vector2f position = mBullets.getPosition(bullet);
+	float radius = mBullets.getRadius(bullet);
+	float extent = radius + mMaxSpriteExtent;
+	Vector2i first = toSpriteCell(position - Vector2f(extent, extent));
+	Vector2i last = toSpriteCell(position + Vector2f(extent, extent));
+	Sprite* hit = nullptr;
+	for (int x = first.x; x <= last.x; x++)
+		for (int y = first.y; y <= last.y; y++) {
+			auto cell = mSpriteCells.find(Vector2i(x, y));
+			if (cell == mSpriteCells.end())
 				continue;
-			if (sprite->testCollision(other, offset,
-					other->getSpeed() * (elapsed / 1000.0f))) {
-				sprite->onCollide(other);
-				other->onCollide(sprite);
+			for (Sprite* sprite : cell->second) {
+				if (sprite->getId() == mBullets.getShooterId(bullet) ||
+						sprite->getCategory() == Sprite::CATEGORY_PARTICLE ||
+						!sprite->collisionEnabled(Sprite::CATEGORY_PARTICLE) ||
+						(hit && hit->getCategory() <= sprite->getCategory()))
+					continue;
+				const Circle* circle = dynamic_cast<const Circle*>(sprite);
+				if ((circle != nullptr)
+						? thor::squaredLength(position - circle->getPosition()) <
+								(radius + circle->getRadius()) * (radius + circle->getRadius())
+						: circleHitsRect(position, radius, sprite->getPosition(),
+								sprite->getHalfSize(), sprite->getDirectionVector()))
+					hit = sprite;
 			}
 		}
+	return hit;
+}
+
+/**
+ * Tests sprite for overlap with every other sprite (considering collision
+ * masks), and shortens its movement in mBodies so that it does not overlap.
+ *
+ * Only sprites returned by getCollisionCandidates are tested exactly,
+ * which already excludes those that are filtered by masks or too far away.
+ *
+ * @param candidates Buffer for the result of getCollisionCandidates, so
+ * 					 that it is only allocated once per step.
+ */
+void
+World::resolveCollisions(std::shared_ptr<Sprite> sprite,
+		std::vector<std::shared_ptr<Sprite> >& candidates) {
+	Vector2f offset = mBodies.getOffset(*sprite);
+	getCollisionCandidates(*sprite, candidates);
+	for (const auto& other : candidates) {
+		if (sprite->testCollision(other, offset, mBodies.getOffset(*other))) {
+			if (Trace::isEnabled())
+				Trace::record(Trace::COLLISION, sprite->getId(), other->getId(),
+						sprite->getPosition().x, sprite->getPosition().y);
+			sprite->onCollide(other);
+			other->onCollide(sprite);
+		}
 	}
-	sprite->setPosition(sprite->getPosition() + offset);
+	mBodies.setOffset(*sprite, offset);
+}
+
+/**
+ * Replaces the contents of candidates with all sprites that sprite may
+ * collide with during the current step, ordered by category and id. These
+ * are all sprites whose collision filters match and whose reach overlaps
+ * the reach of sprite on both axes, except sprite itself.
+ *
+ * Tiles are taken from mTileChunks and other sprites from mSpriteCells,
+ * so only sprites near sprite are visited.
+ */
+void
+World::getCollisionCandidates(const Sprite& sprite,
+		std::vector<std::shared_ptr<Sprite> >& candidates) const {
+	Vector2f position = sprite.getPosition();
+	float reach = mBodies.getReach(sprite);
+	auto add = [&](const std::shared_ptr<Sprite>& other) {
+		float distance = reach + mBodies.getReach(*other);
+		Vector2f difference = other->getPosition() - position;
+		if (std::abs(difference.x) <= distance &&
+				std::abs(difference.y) <= distance &&
+				sprite.collisionEnabled(other->getCategory()) &&
+				other->collisionEnabled(sprite.getCategory()) &&
+				other.get() != &sprite)
+			candidates.push_back(other);
+	};
+	candidates.clear();
+
+	if (sprite.collisionEnabled(Sprite::CATEGORY_WORLD)) {
+		// Tile positions are the tile centers, and tiles never move.
+		float extent = reach + thor::length(Vector2f(Tile::TILE_SIZE) / 2.0f);
+		Vector2i first(std::floor((position.x - extent) / Tile::TILE_SIZE.x),
+				std::floor((position.y - extent) / Tile::TILE_SIZE.y));
+		Vector2i last(std::ceil((position.x + extent) / Tile::TILE_SIZE.x),
+				std::ceil((position.y + extent) / Tile::TILE_SIZE.y));
+		for (int x = first.x; x <= last.x; x++)
+			for (int y = first.y; y <= last.y; y++) {
+				std::shared_ptr<Tile> tile = getTile(Vector2i(x, y));
+				if (tile)
+					add(tile);
+			}
+	}
+
+	// Sprites in mSpriteCells reach no further than their extent, or the
+	// largest reach of a moving body.
+	float extent = reach + std::max(mMaxSpriteExtent,
+			mBodies.getMaxActiveReach());
+	Vector2i first = toSpriteCell(position - Vector2f(extent, extent));
+	Vector2i last = toSpriteCell(position + Vector2f(extent, extent));
+	for (int x = first.x; x <= last.x; x++)
+		for (int y = first.y; y <= last.y; y++) {
+			auto cell = mSpriteCells.find(Vector2i(x, y));
+			if (cell == mSpriteCells.end())
+				continue;
+			for (Sprite* other : cell->second)
+				add(other->shared_from_this());
+		}
+
+	std::sort(candidates.begin(), candidates.end(),
+			[](const std::shared_ptr<Sprite>& a, const std::shared_ptr<Sprite>& b) {
+				return std::make_pair(a->getCategory(), a->getId()) <
+						std::make_pair(b->getCategory(), b->getId());
+			});
 }
 
 /**
@@ -142,10 +566,139 @@ World::draw(sf::RenderTarget& target, sf::RenderStates states) const {
 	sf::FloatRect screen(target.getViewport(target.getView()));
 	screen.left += target.getView().getCenter().x - target.getView().getSize().x / 2;
 	screen.top += target.getView().getCenter().y - target.getView().getSize().y / 2;
-	for (auto v = mDrawables.begin(); v != mDrawables.end(); v++)
-		for (const auto& item : v->second)
-			if (item->isInside(screen))
-				target.draw(static_cast<sf::Drawable&>(*item), states);
+	mDrawCalls = 0;
+	// Tiles have the lowest category, so they are drawn first.
+	drawTiles(target, states, screen);
+
+	// Only cells that may contain a sprite intersecting screen.
+	Vector2i first = toSpriteCell(Vector2f(screen.left - mMaxSpriteExtent,
+			screen.top - mMaxSpriteExtent));
+	Vector2i last = toSpriteCell(Vector2f(
+			screen.left + screen.width + mMaxSpriteExtent,
+			screen.top + screen.height + mMaxSpriteExtent));
+	// Category, then texture group (0 for the atlas, texture id + 1 for any
+	// other), then insertion order.
+	std::vector<std::pair<std::tuple<Sprite::Category, Loader::ResourceId,
+			unsigned long>, const Sprite*> > visible;
+	for (int x = first.x; x <= last.x; x++)
+		for (int y = first.y; y <= last.y; y++) {
+			auto cell = mSpriteCells.find(Vector2i(x, y));
+			if (cell == mSpriteCells.end())
+				continue;
+			for (const Sprite* sprite : cell->second)
+				if (sprite->isInside(screen))
+					visible.push_back(std::make_pair(std::make_tuple(
+							sprite->getCategory(),
+							(mAtlas.contains(sprite->mTextureId))
+									? 0
+									: sprite->mTextureId + 1,
+							mSpriteIndex.at(sprite).order), sprite));
+		}
+
+	// Restore render order by category. Within a category, sprites from the
+	// atlas come first so they end up in a single batch, the others are
+	// grouped by texture to avoid texture switches.
+	std::sort(visible.begin(), visible.end());
+	std::vector<const Sprite*> sprites;
+	sprites.reserve(visible.size());
+	for (const auto& v : visible)
+		sprites.push_back(v.second);
+	drawSprites(target, states, sprites, screen);
+}
+
+/**
+ * Draws sprites in the given order, and bullets before the first sprite
+ * with a category above Sprite::CATEGORY_PARTICLE.
+ *
+ * Sprites with a texture in mAtlas are collected into a single vertex array.
+ * Any other sprite is drawn on its own, after drawing those collected before
+ * it to keep the order.
+ */
+void
+World::drawSprites(sf::RenderTarget& target, sf::RenderStates states,
+		const std::vector<const Sprite*>& sprites,
+		const sf::FloatRect& screen) const {
+	sf::RenderStates batchStates = states;
+	batchStates.texture = &mAtlas.getTexture();
+	auto flush = [&]() {
+		if (mBatch.getVertexCount() == 0)
+			return;
+		target.draw(mBatch, batchStates);
+		mDrawCalls++;
+		mBatch.clear();
+	};
+
+	bool bulletsAppended = false;
+	for (const Sprite* item : sprites) {
+		if (!bulletsAppended && item->getCategory() > Sprite::CATEGORY_PARTICLE) {
+			mBullets.appendQuads(mBatch, screen);
+			bulletsAppended = true;
+		}
+		if (appendSprite(*item, mBatch))
+			continue;
+		flush();
+		target.draw(static_cast<const sf::Drawable&>(*item), states);
+		mDrawCalls++;
+	}
+	if (!bulletsAppended)
+		mBullets.appendQuads(mBatch, screen);
+	flush();
+}
+
+/**
+ * Appends a textured quad for sprite to vertices.
+ *
+ * @return False if the texture of sprite is not in mAtlas, nothing is
+ * 		   appended in that case.
+ */
+bool
+World::appendSprite(const Sprite& sprite, sf::VertexArray& vertices) const {
+	if (!mAtlas.contains(sprite.mTextureId))
+		return false;
+	// Same as the texture rect set in Sprite, but limited to the image.
+	sf::FloatRect texture(mAtlas.getRect(sprite.mTextureId));
+	Vector2f size = sprite.getSize();
+	texture.width = std::min(texture.width, size.x);
+	texture.height = std::min(texture.height, size.y);
+
+	sf::Transform transform;
+	transform.translate(sprite.getPosition());
+	transform *= sprite.mShape.getTransform();
+	vertices.append(sf::Vertex(transform.transformPoint(0, 0),
+			Vector2f(texture.left, texture.top)));
+	vertices.append(sf::Vertex(transform.transformPoint(size.x, 0),
+			Vector2f(texture.left + texture.width, texture.top)));
+	vertices.append(sf::Vertex(transform.transformPoint(size.x, size.y),
+			Vector2f(texture.left + texture.width, texture.top + texture.height)));
+	vertices.append(sf::Vertex(transform.transformPoint(0, size.y),
+			Vector2f(texture.left, texture.top + texture.height)));
+	return true;
+}
+
+/**
+ * Draws all tile chunks that intersect screen, with one draw call each.
+ */
+void
+World::drawTiles(sf::RenderTarget& target, sf::RenderStates states,
+		const sf::FloatRect& screen) const {
+	states.texture = &mAtlas.getTexture();
+	Vector2f size(Tile::TILE_SIZE * TILE_CHUNK_SIZE);
+	for (const auto& chunk : mTileChunks) {
+		sf::FloatRect bounds(Tile::toPosition(chunk.first * TILE_CHUNK_SIZE) -
+				Vector2f(Tile::TILE_SIZE) / 2.0f, size);
+		if (screen.intersects(bounds)) {
+			target.draw(chunk.second.vertices, states);
+			mDrawCalls++;
+		}
+	}
+}
+
+/**
+ * Returns the number of draw calls issued by the last call to draw.
+ */
+int
+World::getDrawCalls() const {
+	return mDrawCalls;
 }
 
 /*
@@ -159,6 +712,7 @@ World::draw(sf::RenderTarget& target, sf::RenderStates states) const {
 bool
 World::raycast(const Vector2f& lineStart,
 		const Vector2f& lineEnd) const {
+	ProfileZone zone("World::raycast");
 	assert(lineStart != lineEnd);
 	Vector2f lineCenter = lineStart + 0.5f * (lineEnd - lineStart);
 	for (const auto& it : mDrawables.at(Sprite::Category::CATEGORY_WORLD)) {
@@ -169,7 +723,7 @@ World::raycast(const Vector2f& lineStart,
 			return false;
 
 		axis = thor::unitVector(axis);
-		Vector2f halfsize = it->getSize() / 2.0f;
+		Vector2f halfsize = it->getHalfSize();
 		float rectPosProjected = thor::dotProduct(axis, it->getPosition());
 		float lineStartProjected = thor::dotProduct(axis, lineStart);
 		float lineEndProjected = thor::dotProduct(axis, lineEnd);
@@ -8,11 +8,20 @@
 #ifndef DG_WORLD_H_
 #define DG_WORLD_H_
 
+#include <array>
+#include <map>
+#include <unordered_map>
+
+#include "BodyStore.h"
+#include "BulletSystem.h"
 #include "sprites/abstract/Character.h"
 #include "sprites/abstract/Sprite.h"
+#include "sprites/Tile.h"
+#include "util/TextureAtlas.h"
 
 class Character;
 class Sprite;
+class Tile;
 
 /**
  * A collection of sprites, which can be put into different layers.
@@ -22,9 +31,17 @@ class Sprite;
  */
 class World : public sf::Drawable {
 public:
+	World();
+	static std::vector<std::string> getAtlasFiles();
 	void insert(std::shared_ptr<Sprite> drawable);
 	void insertCharacter(std::shared_ptr<Character> character);
+	void insertTile(std::shared_ptr<Tile> tile);
+	void insertBullet(const Vector2f& position, const Character& shooter,
+			const Vector2f& direction, const BulletConfig& config, float speed,
+			int damage, float maxRange);
 	void remove(std::shared_ptr<Sprite> drawable);
+	std::shared_ptr<Tile> getTile(const Vector2i& position) const;
+	void updateTile(const Tile& tile);
 	void step(int elapsed);
 	void think(int elapsed);
 	std::vector<std::shared_ptr<Character> >
@@ -34,16 +51,91 @@ public:
 	std::vector<std::shared_ptr<Sprite> > getNearbySprites(
 			const Vector2f& position, float radius) const;
 	std::shared_ptr<Item> getClosestItem(const Vector2f& position) const;
+	int getDrawCalls() const;
+	void wake(Sprite& sprite);
 
 private:
+	/// Side length of the squares in which tiles are stored.
+	static const int TILE_CHUNK_SIZE = 16;
+	/// Side length in pixels of the squares used to find visible sprites.
+	static const int SPRITE_CELL_SIZE = 256;
+
+	/**
+	 * Square of TILE_CHUNK_SIZE * TILE_CHUNK_SIZE tiles.
+	 */
+	struct TileChunk {
+		/// Tiles in row major order, null where no tile has been inserted.
+		std::array<std::shared_ptr<Tile>, TILE_CHUNK_SIZE * TILE_CHUNK_SIZE> tiles;
+		/// One quad for each element of tiles, in the same order. Quads
+		/// without a tile have zero size.
+		sf::VertexArray vertices = sf::VertexArray(sf::Quads,
+				4 * TILE_CHUNK_SIZE * TILE_CHUNK_SIZE);
+	};
+
+	/**
+	 * Location of a sprite (other than a tile) in mSpriteCells.
+	 */
+	struct SpriteCell {
+		Vector2i cell;
+		/// Number of sprites inserted before this one, to keep the draw
+		/// order within a category.
+		unsigned long order;
+	};
 
 private:
     void draw(sf::RenderTarget& target, sf::RenderStates states) const;
-   	void applyMovement(std::shared_ptr<Sprite> sprite, int elapsed);
+   	void drawTiles(sf::RenderTarget& target, sf::RenderStates states,
+   			const sf::FloatRect& screen) const;
+   	void drawSprites(sf::RenderTarget& target, sf::RenderStates states,
+   			const std::vector<const Sprite*>& sprites,
+   			const sf::FloatRect& screen) const;
+   	void insertIntoCell(Sprite* sprite, const SpriteCell& cell);
+   	void removeFromCell(Sprite* sprite);
+   	void updateCell(Sprite* sprite);
+   	static Vector2i toSpriteCell(const Vector2f& position);
+   	bool appendSprite(const Sprite& sprite, sf::VertexArray& vertices) const;
+   	void resolveCollisions(std::shared_ptr<Sprite> sprite,
+   			std::vector<std::shared_ptr<Sprite> >& candidates);
+   	void getCollisionCandidates(const Sprite& sprite,
+   			std::vector<std::shared_ptr<Sprite> >& candidates) const;
+   	void stepBullets(int elapsed);
+   	bool bulletHitsTile(const Vector2f& position, float radius) const;
+   	Sprite* getBulletHit(size_t bullet) const;
+   	static Vector2i toTileChunk(const Vector2i& position);
+   	static int toTileIndex(const Vector2i& position);
 
 private:
 	std::map<Sprite::Category, std::vector<std::shared_ptr<Sprite> > > mDrawables;
+	/// Sprites that are moving or marked for deletion, the only ones
+	/// visited by step. Others are added by wake.
+	std::vector<std::shared_ptr<Sprite> > mActiveSprites;
 	std::vector<std::shared_ptr<Character> > mCharacters;
+	/// Positions and speeds of all sprites, including tiles. Bodies of
+	/// sprites in mActiveSprites are active.
+	BodyStore mBodies;
+	/// Bullets are not sprites, they are moved and drawn separately.
+	BulletSystem mBullets;
+	/// Tiles by chunk position (tile position / TILE_CHUNK_SIZE).
+	std::unordered_map<Vector2i, TileChunk> mTileChunks;
+	/// All sprites except tiles by the cell containing their position
+	/// (position / SPRITE_CELL_SIZE).
+	std::unordered_map<Vector2i, std::vector<Sprite*> > mSpriteCells;
+	/// Cell in mSpriteCells for every sprite that is stored there.
+	std::unordered_map<const Sprite*, SpriteCell> mSpriteIndex;
+	/// Number of sprites inserted into mSpriteCells so far.
+	unsigned long mSpriteInsertions = 0;
+	/// Largest distance from position to bounding box edge of any sprite
+	/// in mSpriteCells, regardless of rotation.
+	float mMaxSpriteExtent = 0;
+	/// Textures of all tile types and most sprites, so they can be drawn
+	/// in batches.
+	TextureAtlas mAtlas;
+	/// Position of each tile type's texture in mAtlas.
+	std::map<Tile::Type, sf::IntRect> mTileTextures;
+	/// Quads of visible sprites, reused between frames.
+	mutable sf::VertexArray mBatch = sf::VertexArray(sf::Quads);
+	/// Number of draw calls issued during the last call to draw.
+	mutable int mDrawCalls = 0;
 };
 
 #endif /* DG_WORLD_H_ */
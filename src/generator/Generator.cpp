@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <assert.h>
 #include <map>
+#include <queue>
 #include <set>
 
 #include <SFML/System.hpp>
@@ -19,21 +20,91 @@
 #include "../Pathfinder.h"
 #include "../World.h"
 #include "../sprites/Enemy.h"
-#include "../util/Yaml.h"
+#include "../util/ConfigWatcher.h"
+#include "../util/Profiler.h"
+#include "../util/Trace.h"
+#include "LocalGrid.h"
+
+namespace {
+
+/**
+ * Covers all set values in open with rectangles, greedily growing each
+ * rectangle to the right first, then downwards. Clears open.
+ *
+ * @param open Values in row major order.
+ * @param bounds Position and size of open.
+ */
+std::vector<sf::IntRect>
+mergeRectangles(std::vector<char>& open, const sf::IntRect& bounds) {
+	auto isOpen = [&open, &bounds](int x, int y) -> char& {
+		return open[(y - bounds.top) * bounds.width + x - bounds.left];
+	};
+	std::vector<sf::IntRect> rectangles;
+	for (int y = bounds.top; y < bounds.top + bounds.height; y++)
+		for (int x = bounds.left; x < bounds.left + bounds.width; x++) {
+			if (!isOpen(x, y))
+				continue;
+			int right = x + 1;
+			while (right < bounds.left + bounds.width && isOpen(right, y))
+				right++;
+			int bottom = y + 1;
+			while (bottom < bounds.top + bounds.height &&
+					std::all_of(&isOpen(x, bottom), &isOpen(x, bottom) + right - x,
+							[](char c) {return c;}))
+				bottom++;
+			for (int i = y; i < bottom; i++)
+				std::fill(&isOpen(x, i), &isOpen(x, i) + right - x, false);
+			rectangles.push_back(sf::IntRect(x, y, right - x, bottom - y));
+		}
+	return rectangles;
+}
+
+}
+
+const ConfigFields<GeneratorConfig>&
+GeneratorConfig::getFields() {
+	static const ConfigFields<GeneratorConfig> fields = ConfigFields<GeneratorConfig>()
+			.add("generate_area_size", &GeneratorConfig::generateAreaSize)
+			.add("generate_area_range", &GeneratorConfig::generateAreaRange)
+			.add("room_size_value", &GeneratorConfig::roomSizeValue)
+			.add("room_connection_value", &GeneratorConfig::roomConnectionValue)
+			.add("enemy_generation_chance", &GeneratorConfig::enemyGenerationChance)
+			.add("merge_navigation_areas", &GeneratorConfig::mergeNavigationAreas);
+	return fields;
+}
+
+const std::string Generator::CONFIG_NAME = "generation.yaml";
 
 /**
  * Generates new random seed.
  */
 Generator::Generator(World& world, Pathfinder& pathfinder,
-		ltbl::LightSystem& lightSystem, const Yaml& config) :
-		mAreaSize(config.get("generate_area_size", 1)),
-		mMaxRange((config.get("generate_area_range", 1.0f) / mAreaSize) / Tile::TILE_SIZE.x),
-		mRoomSizeValue(config.get("room_size_value", 1.0f)),
-		mRoomConnectionValue(config.get("room_connection_value", 1.0f)),
-		mEnemyGenerationChance(config.get("enemy_generation_chance", 0.0f) * 2 - 1),
+		ltbl::LightSystem& lightSystem) :
+		mAreaSize(loadConfig<GeneratorConfig>(CONFIG_NAME)->generateAreaSize),
 		mWorld(world),
 		mPathfinder(pathfinder),
 		mLightSystem(lightSystem) {
+	applyConfig(*loadConfig<GeneratorConfig>(CONFIG_NAME));
+	mConfigSubscription = ConfigWatcher::i().subscribe(CONFIG_NAME, [this]() {
+		applyConfig(*loadConfig<GeneratorConfig>(CONFIG_NAME));
+	});
+}
+
+Generator::~Generator() {
+	ConfigWatcher::i().unsubscribe(mConfigSubscription);
+}
+
+/**
+ * Takes generation parameters from config, they are used for all areas
+ * generated afterwards.
+ */
+void
+Generator::applyConfig(const GeneratorConfig& config) {
+	mMaxRange = (config.generateAreaRange / mAreaSize) / Tile::TILE_SIZE.x;
+	mRoomSizeValue = config.roomSizeValue;
+	mRoomConnectionValue = config.roomConnectionValue;
+	mEnemyGenerationChance = config.enemyGenerationChance * 2 - 1;
+	mMergeAreas = config.mergeNavigationAreas;
 }
 
 /**
@@ -63,10 +134,9 @@ Generator::generateCurrentAreaIfNeeded(const Vector2f& position) {
 		closed.insert(current);
 		if (!mGenerated[current.x][current.y] && distance <= mMaxRange) {
 			mGenerated[current.x][current.y] = true;
-			sf::IntRect area(current * mAreaSize -
-					Vector2i(mAreaSize, mAreaSize) / 2,
-					Vector2i(mAreaSize, mAreaSize));
+			sf::IntRect area = getChunkArea(current);
 			generateTiles(area);
+			computeClosestFloors(current);
 			auto spawnTemp = getEnemySpawns(area);
 			enemySpawns.insert(enemySpawns.end(), spawnTemp.begin(), spawnTemp.end());
 		}
@@ -87,33 +157,33 @@ Generator::generateCurrentAreaIfNeeded(const Vector2f& position) {
 /**
  * Generates a minimum spanning tree on mTileNoise, starting from start with
  * a maximum total node weight of limit.
- */
+ *
+ * Uses Prim's algorithm, with node weights kept in a heap. Every point is
+ * inserted into the heap at most once, so no point is selected twice.
+ */
 std::vector<Vector2i>
 Generator::createMinimalSpanningTree(const Vector2i& start,
 		const float limit) {
-	std::vector<Vector2i> open;
-	std::vector<Vector2i> selected;
-	open.push_back(start);
-	float totalWeight = 0.0f;
+	typedef std::pair<float, Vector2i> Node;
+	std::priority_queue<Node, std::vector<Node>, std::greater<Node> > open;
+	LocalGrid<char> inserted(start, mAreaSize, false);
+	std::vector<Vector2i> selected;
+
+	auto insertNew = [&open, &inserted, this](const Vector2i& v) {
+		if (!inserted[v]) {
+			inserted[v] = true;
+			open.push(std::make_pair(mTileNoise.getNoise(v) + 1.0f, v));
+		}
+	};
 
+	insertNew(start);
+	float totalWeight = 0.0f;
 	while (totalWeight < limit) {
-		Vector2i current;
-		float minValue = std::numeric_limits<float>::max();
-		for (auto& o : open) {
-			if (mTileNoise.getNoise(o) + 1.0f < minValue) {
-				current = o;
-				minValue = mTileNoise.getNoise(o) + 1.0f;
-			}
-		}
-		std::remove(open.begin(), open.end(), current);
+		Vector2i current = open.top().second;
+		totalWeight += open.top().first;
+		open.pop();
 		selected.push_back(current);
-		totalWeight += minValue;
 
-		auto insertNew = [&open, &selected](const Vector2i& v) {
-			if (std::find(open.begin(), open.end(),	v) == open.end()
-					&& std::find(selected.begin(), selected.end(), v) == selected.end())
-				open.push_back(v);
-		};
 		insertNew(Vector2i(current.x + 1, current.y));
 		insertNew(Vector2i(current.x, current.y + 1));
 		insertNew(Vector2i(current.x - 1, current.y));
@@ -126,46 +196,47 @@ Generator::createMinimalSpanningTree(const Vector2i& start,
  * Generates paths that connect different rooms.
  *
  * Using basically Dijkstra on infinite graph/A* without destination node.
+ * Open nodes are kept in a heap with lazy deletion, entries for nodes that
+ * have already been closed are skipped when popped.
  *
  * @param start Tile to start path generation from (must be floor).
+ * @return All tiles that were changed to floor.
  */
-void
+std::vector<Vector2i>
 Generator::connectRooms(const Vector2i& start) {
-	std::set<Vector2i> open;
-	std::set<Vector2i> closed;
-	std::map<Vector2i, Vector2i> previous;
+	typedef std::pair<float, Vector2i> Node;
+	std::priority_queue<Node, std::vector<Node>, std::greater<Node> > open;
+	LocalGrid<char> closed(start, mAreaSize, false);
+	LocalGrid<Vector2i> previous(start, mAreaSize, start);
+	LocalGrid<float> distance(start, mAreaSize,
+			std::numeric_limits<float>::max());
 	std::set<Vector2i> destinations;
-	std::map<Vector2i, float> distance;
-	// Compares vectors using distance values.
-	auto comp = [&distance](const Vector2i& lhs, const Vector2i& rhs) {
-		return distance[lhs] < distance[rhs];
-	};
 	auto process = [&open, &closed, &previous, &distance, this](const Vector2i& point, const Vector2i& current) {
 		// Update previous nodes if shorter path is found.
-		if (distance.count(point) == 0) {
-			distance[point] = distance[current] + mTileNoise.getNoise(point) + 1;
+		float newDistance = distance.get(current) + mTileNoise.getNoise(point) + 1;
+		if (!closed.get(point) && newDistance < distance.get(point)) {
+			distance[point] = newDistance;
 			previous[point] = current;
+			open.push(std::make_pair(newDistance, point));
 		}
-
-		// Insert into open
-		if (closed.count(point) == 0)
-			open.insert(point);
 	};
 
-	open.insert(start);
+	open.push(std::make_pair(0.0f, start));
 	distance[start] = 0;
 	while (!open.empty()) {
 		// Select node with lowest distance that is in open
-		Vector2i current = *std::min_element(open.begin(), open.end(), comp);
-		open.erase(current);
-		closed.insert(current);
+		Vector2i current = open.top().second;
+		open.pop();
+		if (closed.get(current))
+			continue;
+		closed[current] = true;
 		// Take all floors right after wall tiles.
-		if (mTiles[previous[current].x][previous[current].y] == Tile::Type::WALL &&
-				mTiles[current.x][current.y] == Tile::Type::FLOOR) {
+		if (current != start && !isFloor(previous.get(current)) &&
+				isFloor(current)) {
 			destinations.insert(current);
 			break;
 		}
-		if (distance.at(current) < mRoomConnectionValue) {
+		if (distance.get(current) < mRoomConnectionValue) {
 			process(Vector2i(current.x + 1, current.y), current);
 			process(Vector2i(current.x,     current.y + 1), current);
 			process(Vector2i(current.x - 1, current.y), current);
@@ -173,6 +244,7 @@ Generator::connectRooms(const Vector2i& start) {
 		}
 	}
 
+	std::vector<Vector2i> carved;
 	float totalValue = 0.0f;
 	while (totalValue < mRoomConnectionValue && !destinations.empty()) {
 		std::vector<Vector2i> path;
@@ -180,23 +252,34 @@ Generator::connectRooms(const Vector2i& start) {
 		Vector2i current = *destinations.begin();
 		destinations.erase(destinations.begin());
 		while (current != start) {
-			path.push_back(previous[current]);
+			path.push_back(previous.get(current));
 			pathValue += mTileNoise.getNoise(current);
-			current = previous[current];
+			current = previous.get(current);
 		};
 		path.push_back(start);
 		mPaths.push_back(path);
+		carved.insert(carved.end(), path.begin(), path.end());
+		std::set<Vector2i> changedChunks;
+		std::set<Vector2i> changedHulls;
 		for (const auto& p : path) {
 			mTiles[p.x][p.y] = Tile::Type::FLOOR;
 			Tile::setTile(p, Tile::Type::FLOOR, mWorld);
-			for (auto it = mHulls.begin(); it != mHulls.end(); it++)
-				if ((*it)->GetWorldCenter() == Tile::toPosition(Vector2i(p.x, p.y)).toVec2f()) {
-					mLightSystem.RemoveConvexHull(*it);
-					mHulls.erase(it);
-					break;
-				}
+
+			if (mChunks.count(toChunk(p)) != 0)
+				changedChunks.insert(toChunk(p));
+			// New floor also exposes walls in neighbouring areas.
+			for (int x = -1; x <= 1; x++)
+				for (int y = -1; y <= 1; y++)
+					if (mChunks.count(toChunk(p + Vector2i(x, y))) != 0)
+						changedHulls.insert(toChunk(p + Vector2i(x, y)));
 		}
+		// Paths may lead into areas that were generated before.
+		for (const auto& c : changedChunks)
+			computeClosestFloors(c);
+		for (const auto& c : changedHulls)
+			rebuildHulls(c);
 	}
+	return carved;
 }
 
 /**
@@ -214,16 +297,19 @@ Generator::generateTiles(const sf::IntRect& area) {
 	// Width and height must be a power of two.
 	assert(area.width && !(area.width & (area.width - 1)));
 	assert(area.height && !(area.height & (area.height - 1)));
+	ProfileZone zone("Generator::generateTiles");
+	sf::Clock clock;
 
     Vector2i start;
     float minValue = std::numeric_limits<float>::max();
 
     // Find lowest value for tree start.
-	for (int x = area.left; x < area.left + area.width; x++)
-		for (int y = area.top; y < area.top + area.height; y++) {
-			if (mTileNoise.getNoise(x, y) + 1.0f < minValue) {
-                start = Vector2i(x, y);
-                minValue = mTileNoise.getNoise(x, y) + 1.0f;
+	std::vector<float> noise = mTileNoise.getNoise(area);
+	for (int x = 0; x < area.width; x++)
+		for (int y = 0; y < area.height; y++) {
+			if (noise[y * area.width + x] + 1.0f < minValue) {
+                start = Vector2i(area.left + x, area.top + y);
+                minValue = noise[y * area.width + x] + 1.0f;
 			}
 		}
 
@@ -251,28 +337,26 @@ Generator::generateTiles(const sf::IntRect& area) {
 			if (mTiles[x].count(y) == 0)
 				mTiles[x][y] = Tile::Type::FLOOR;
 
-	connectRooms(start);
+	std::vector<Vector2i> carved = connectRooms(start);
 	for (int x = area.left; x < area.left + area.width; x++)
-		for (int y = area.top; y < area.top + area.height; y++) {
-			mWorld.insert(std::shared_ptr<Sprite>(
-					new Tile(Vector2i(x, y), mTiles[x][y])));
-			if (mTiles[x][y] == Tile::Type::WALL) {
-				ltbl::ConvexHull* tileHull = new ltbl::ConvexHull();
-				tileHull->m_vertices.push_back(Vec2f(-37.5f,  37.5f));
-				tileHull->m_vertices.push_back(Vec2f(-37.5f, -37.5f));
-				tileHull->m_vertices.push_back(Vec2f( 37.5f, -37.5f));
-				tileHull->m_vertices.push_back(Vec2f( 37.5f,  37.5f));
-				tileHull->m_renderLightOverHull = false;
-				tileHull->CalculateNormals();
-				tileHull->CalculateAABB();
-				tileHull->SetWorldCenter(Tile::toPosition(Vector2i(x, y)).toVec2f());
-				mLightSystem.AddConvexHull(tileHull);
-				mHulls.push_back(tileHull);
-			}
-		}
-
-	generateAreas(area);
+		for (int y = area.top; y < area.top + area.height; y++)
+			Tile::setTile(Vector2i(x, y), mTiles[x][y], mWorld);
+
+	// Walls at the border of neighbouring areas may now be next to floor.
+	Vector2i chunk = toChunk(Vector2i(area.left, area.top));
+	for (int x = -1; x <= 1; x++)
+		for (int y = -1; y <= 1; y++)
+			if (mChunks.count(chunk + Vector2i(x, y)) != 0 ||
+					(x == 0 && y == 0))
+				rebuildHulls(chunk + Vector2i(x, y));
+
+	if (mMergeAreas)
+		generateMergedAreas(area, carved);
+	else
+		generateAreas(area);
 	mPathfinder.generatePortals();
+	Trace::record(Trace::GENERATE_TILES, area.left, area.top,
+			clock.getElapsedTime().asMicroseconds() / 1000.0f, 0);
 }
 
 /**
@@ -284,11 +368,12 @@ Generator::generateTiles(const sf::IntRect& area) {
 std::vector<Vector2f>
 Generator::getEnemySpawns(const sf::IntRect& area) {
 	std::vector<Vector2f> spawns;
-	for (int x = area.left; x < area.left + area.width; x++) {
-		for (int y = area.top; y < area.top + area.height; y++) {
-			float noise = mCharacterNoise.getNoise(x, y);
-			if (noise <= mEnemyGenerationChance) {
-				Vector2i tilePosition = findClosestFloor(Vector2i(x, y));
+	std::vector<float> noise = mCharacterNoise.getNoise(area);
+	for (int x = 0; x < area.width; x++) {
+		for (int y = 0; y < area.height; y++) {
+			if (noise[y * area.width + x] <= mEnemyGenerationChance) {
+				Vector2i tilePosition = findClosestFloor(
+						Vector2i(area.left + x, area.top + y));
 				spawns.push_back(Vector2f(tilePosition.x * Tile::TILE_SIZE.x,
 						tilePosition.y * Tile::TILE_SIZE.y));
 			}
@@ -330,6 +415,63 @@ Generator::generateAreas(const sf::IntRect& area) {
 	}
 }
 
+/**
+ * Inserts floor tiles into path finder, merging them greedily into
+ * rectangles that are as large as possible.
+ *
+ * Areas in and around the new area (and around tiles that connectRooms
+ * changed in previously generated areas) are removed from the path finder
+ * and merged again together with the new tiles, so that rectangles can
+ * extend over borders between generated areas.
+ *
+ * @param area The area to generate areas for.
+ * @param carved Tiles that were changed to floor by connectRooms.
+ */
+void
+Generator::generateMergedAreas(const sf::IntRect& area,
+		const std::vector<Vector2i>& carved) {
+	// Extends rect so it contains other.
+	auto extend = [](sf::IntRect& rect, const sf::IntRect& other) {
+		int right = std::max(rect.left + rect.width, other.left + other.width);
+		int bottom = std::max(rect.top + rect.height, other.top + other.height);
+		rect.left = std::min(rect.left, other.left);
+		rect.top = std::min(rect.top, other.top);
+		rect.width = right - rect.left;
+		rect.height = bottom - rect.top;
+	};
+
+	sf::IntRect region(area.left - mAreaSize, area.top - mAreaSize,
+			area.width + 2 * mAreaSize, area.height + 2 * mAreaSize);
+	for (const auto& c : carved)
+		extend(region, sf::IntRect(c.x - 1, c.y - 1, 3, 3));
+	std::vector<sf::IntRect> removed = mPathfinder.removeAreas(region);
+
+	sf::IntRect bounds = region;
+	for (const auto& r : removed)
+		extend(bounds, r);
+
+	// Tiles that still have to be inserted into the path finder.
+	std::vector<char> open(bounds.width * bounds.height, false);
+	auto isOpen = [&open, &bounds](int x, int y) -> char& {
+		return open[(y - bounds.top) * bounds.width + x - bounds.left];
+	};
+	for (int x = region.left; x < region.left + region.width; x++)
+		for (int y = region.top; y < region.top + region.height; y++) {
+			Vector2i chunk = toChunk(Vector2i(x, y));
+			auto column = mGenerated.find(chunk.x);
+			if (column != mGenerated.end() && column->second.count(chunk.y) != 0 &&
+					column->second.at(chunk.y) && isFloor(Vector2i(x, y)))
+				isOpen(x, y) = true;
+		}
+	for (const auto& r : removed)
+		for (int x = r.left; x < r.left + r.width; x++)
+			for (int y = r.top; y < r.top + r.height; y++)
+				isOpen(x, y) = true;
+
+	for (const auto& r : mergeRectangles(open, bounds))
+		mPathfinder.insertArea(sf::FloatRect(r));
+}
+
 /**
  * Returns a valid position (floor) for the player to spawn at.
  */
@@ -340,28 +482,63 @@ Generator::getPlayerSpawn() const {
 						spawn.y * Tile::TILE_SIZE.y);
 }
 
+/**
+ * Returns the number of light hulls in the area containing position, zero
+ * if it has not been generated.
+ */
+int
+Generator::getHullCount(const Vector2f& position) const {
+	Vector2i tile((int) floor(position.x / Tile::TILE_SIZE.x),
+			(int) floor(position.y / Tile::TILE_SIZE.y));
+	auto chunk = mChunks.find(toChunk(tile));
+	return (chunk != mChunks.end()) ? chunk->second.hulls.size() : 0;
+}
+
+/**
+ * Returns a floor tile close to position. This is a lookup of the closest
+ * floor within the same area if that area has been generated and contains
+ * floor, and a search over all tiles otherwise.
+ *
+ * @warn Will fail if no floor tile has been generated yet.
+ * @param position Point to start search for a floor tile from.
+ */
+Vector2i
+Generator::findClosestFloor(const Vector2i& position) const {
+	auto chunk = mChunks.find(toChunk(position));
+	if (chunk == mChunks.end() || chunk->second.closestFloor.empty())
+		return searchClosestFloor(position);
+
+	sf::IntRect area = getChunkArea(chunk->first);
+	return chunk->second.closestFloor[(position.y - area.top) * area.width +
+			position.x - area.left];
+}
+
 /**
  * Finds the point array index closest to position which has a floor tile.
  *
  * @warn Will fail if no floor tile has been generated yet.
  * @position Point to start search for a floor tile from.
- */
+ */
 Vector2i
-Generator::findClosestFloor(const Vector2i& start) const {
+Generator::searchClosestFloor(const Vector2i& start) const {
 	std::map<Vector2i, float> open;
 	std::set<Vector2i> closed;
 	auto insertNew = [&open, &closed, &start](const Vector2i& point) {
 		if (closed.find(point) == closed.end())
-			open.insert(std::make_pair(point, thor::length(Vector2f(point - start))));
+			open.insert(std::make_pair(point, thor::length(Vector2f(point - start))));
+	};
+	// Compares points by distance to start.
+	auto comp = [](const std::pair<Vector2i, float>& lhs,
+			const std::pair<Vector2i, float>& rhs) {
+		return lhs.second < rhs.second;
 	};
 
 	insertNew(start);
 	while (!open.empty()) {
-		Vector2i current = std::min_element(open.begin(), open.end())->first;
+		Vector2i current = std::min_element(open.begin(), open.end(), comp)->first;
 		open.erase(current);
 		closed.insert(current);
-		if (mTiles.count(current.x) != 0 && mTiles.at(current.x).count(current.y) != 0 &&
-				mTiles.at(current.x).at(current.y) == Tile::Type::FLOOR)
+		if (isFloor(current))
 			return current;
 		else {
 			insertNew(Vector2i(current.x + 1, current.y));
@@ -375,6 +552,173 @@ Generator::findClosestFloor(const Vector2i& start) const {
 	return Vector2i();
 }
 
+/**
+ * Stores the closest floor tile for every tile in chunk.
+ *
+ * Uses a two pass euclidean distance transform (Felzenszwalb and
+ * Huttenlocher): First the closest floor in the same column is found for
+ * each tile, then the closest of those is chosen for each row using the
+ * lower envelope of the parabolas (x - column)^2 + distanceInColumn^2.
+ *
+ * @param chunk Area coordinates of a generated area.
+ */
+void
+Generator::computeClosestFloors(const Vector2i& chunk) {
+	sf::IntRect area = getChunkArea(chunk);
+	const int width = area.width;
+	const int height = area.height;
+	// Row of the closest floor in the same column, or -1 if there is none.
+	std::vector<int> columnFloor(width * height, -1);
+	bool hasFloor = false;
+
+	for (int x = 0; x < width; x++) {
+		int last = -1;
+		for (int y = 0; y < height; y++) {
+			if (isFloor(Vector2i(area.left + x, area.top + y)))
+				last = y;
+			columnFloor[y * width + x] = last;
+		}
+		last = -1;
+		for (int y = height - 1; y >= 0; y--) {
+			if (columnFloor[y * width + x] == y)
+				last = y;
+			int& current = columnFloor[y * width + x];
+			if (last != -1 && (current == -1 || last - y < y - current))
+				current = last;
+		}
+		hasFloor |= columnFloor[x] != -1;
+	}
+
+	std::vector<Vector2i>& closest = mChunks[chunk].closestFloor;
+	if (!hasFloor) {
+		closest.clear();
+		return;
+	}
+	closest.resize(width * height);
+
+	// Columns forming the lower envelope, and the x values where each
+	// parabola starts to be the lowest.
+	std::vector<int> envelope(width);
+	std::vector<float> boundaries(width + 1);
+	for (int y = 0; y < height; y++) {
+		auto value = [&columnFloor, width, y](int column) {
+			int distance = y - columnFloor[y * width + column];
+			return (float) (distance * distance + column * column);
+		};
+		int k = -1;
+		for (int column = 0; column < width; column++) {
+			if (columnFloor[y * width + column] == -1)
+				continue;
+			float intersection = - std::numeric_limits<float>::max();
+			while (k >= 0) {
+				intersection = (value(column) - value(envelope[k])) /
+						(2 * (column - envelope[k]));
+				if (intersection > boundaries[k])
+					break;
+				k--;
+			}
+			if (k == -1)
+				intersection = - std::numeric_limits<float>::max();
+			k++;
+			envelope[k] = column;
+			boundaries[k] = intersection;
+			boundaries[k + 1] = std::numeric_limits<float>::max();
+		}
+		for (int x = 0, i = 0; x < width; x++) {
+			while (boundaries[i + 1] < x)
+				i++;
+			closest[y * width + x] = Vector2i(area.left + envelope[i],
+					area.top + columnFloor[y * width + envelope[i]]);
+		}
+	}
+}
+
+/**
+ * Replaces the light hulls of the area at chunk.
+ *
+ * Only walls next to a floor tile can cast a visible shadow, so walls that
+ * are surrounded by other walls are skipped. The remaining walls are merged
+ * into rectangles, each of which gets a single hull.
+ *
+ * @param chunk Area coordinates of a generated area.
+ */
+void
+Generator::rebuildHulls(const Vector2i& chunk) {
+	Chunk& data = mChunks[chunk];
+	for (auto hull : data.hulls)
+		mLightSystem.RemoveConvexHull(hull);
+	data.hulls.clear();
+
+	sf::IntRect area = getChunkArea(chunk);
+	std::vector<char> open(area.width * area.height, false);
+	for (int x = area.left; x < area.left + area.width; x++)
+		for (int y = area.top; y < area.top + area.height; y++) {
+			if (isFloor(Vector2i(x, y)))
+				continue;
+			bool border = false;
+			for (int i = -1; i <= 1 && !border; i++)
+				for (int j = -1; j <= 1 && !border; j++)
+					border = isFloor(Vector2i(x + i, y + j));
+			open[(y - area.top) * area.width + x - area.left] = border;
+		}
+
+	for (const auto& r : mergeRectangles(open, area)) {
+		Vector2f size(thor::cwiseProduct(Vector2i(r.width, r.height),
+				Tile::TILE_SIZE));
+		Vector2f halfSize = size / 2.0f;
+		ltbl::ConvexHull* hull = new ltbl::ConvexHull();
+		hull->m_vertices.push_back(Vec2f(-halfSize.x,  halfSize.y));
+		hull->m_vertices.push_back(Vec2f(-halfSize.x, -halfSize.y));
+		hull->m_vertices.push_back(Vec2f( halfSize.x, -halfSize.y));
+		hull->m_vertices.push_back(Vec2f( halfSize.x,  halfSize.y));
+		hull->m_renderLightOverHull = false;
+		hull->CalculateNormals();
+		hull->CalculateAABB();
+		// Tile positions are tile centers.
+		Vector2f center = Tile::toPosition(Vector2i(r.left, r.top)) +
+				(size - Vector2f(Tile::TILE_SIZE)) / 2.0f;
+		hull->SetWorldCenter(center.toVec2f());
+		mLightSystem.AddConvexHull(hull);
+		data.hulls.push_back(hull);
+	}
+}
+
+/**
+ * Returns the coordinates of the area that contains tile.
+ */
+Vector2i
+Generator::toChunk(const Vector2i& tile) const {
+	auto divide = [this](int value) {
+		value += mAreaSize / 2;
+		return (value >= 0)
+				? value / mAreaSize
+				: (value - mAreaSize + 1) / mAreaSize;
+	};
+	return Vector2i(divide(tile.x), divide(tile.y));
+}
+
+/**
+ * Returns the tiles covered by the area at chunk (in area coordinates).
+ */
+sf::IntRect
+Generator::getChunkArea(const Vector2i& chunk) const {
+	return sf::IntRect(chunk * mAreaSize - Vector2i(mAreaSize, mAreaSize) / 2,
+			Vector2i(mAreaSize, mAreaSize));
+}
+
+/**
+ * Returns true if a floor tile has been generated at position. Does not
+ * insert anything into mTiles.
+ */
+bool
+Generator::isFloor(const Vector2i& position) const {
+	auto column = mTiles.find(position.x);
+	if (column == mTiles.end())
+		return false;
+	auto tile = column->second.find(position.y);
+	return tile != column->second.end() && tile->second == Tile::Type::FLOOR;
+}
+
 /**
  * Debug only: Draws paths generated by connectRooms.
  *
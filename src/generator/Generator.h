@@ -15,11 +15,28 @@
 #include "../sprites/abstract/Character.h"
 #include "../sprites/Tile.h"
 #include "SimplexNoise.h"
+#include "../util/Config.h"
 #include "../util/Vector.h"
 
 class World;
 class Pathfinder;
-class Yaml;
+
+/**
+ * Generation parameters, read from generation.yaml.
+ */
+struct GeneratorConfig {
+	/// Side length of the areas that are generated at once, in tiles.
+	int generateAreaSize = 1;
+	/// Distance from the player within which areas are generated, in pixels.
+	float generateAreaRange = 1;
+	float roomSizeValue = 1;
+	float roomConnectionValue = 1;
+	/// Chance between 0 and 1 to place an enemy at a possible position.
+	float enemyGenerationChance = 0;
+	bool mergeNavigationAreas = false;
+
+	static const ConfigFields<GeneratorConfig>& getFields();
+};
 
 /**
  * Procedurally generates tiles, chooses player and enemy spawn positions.
@@ -27,29 +44,60 @@ class Yaml;
 class Generator : public sf::Drawable {
 public:
 	explicit Generator(World& world, Pathfinder& pathfinder,
-			ltbl::LightSystem& lightSystem, const Yaml& config);
+			ltbl::LightSystem& lightSystem);
+	~Generator();
 	std::vector<Vector2f> generateCurrentAreaIfNeeded(const Vector2f& position);
 	Vector2f getPlayerSpawn() const;
+	int getHullCount(const Vector2f& position) const;
 
 private:
 	typedef std::map<int, std::map<int, Tile::Type> > array;
 
+	/**
+	 * Data that is computed once an area of mAreaSize * mAreaSize tiles
+	 * has been generated.
+	 */
+	struct Chunk {
+		/// Closest floor tile inside the chunk for every tile in it, in row
+		/// major order. Empty if the chunk does not contain any floor.
+		std::vector<Vector2i> closestFloor;
+		/// Merged light hulls for the walls in this chunk that border
+		/// floor, all of which are in the light system.
+		std::vector<ltbl::ConvexHull*> hulls;
+	};
+
 private:
 	void generateAreas(const sf::IntRect& area);
-	void generateTiles(const sf::IntRect& area);
-	Vector2i findClosestFloor(const Vector2i& start) const;
+	void generateMergedAreas(const sf::IntRect& area,
+			const std::vector<Vector2i>& carved);
+	void generateTiles(const sf::IntRect& area);
+	Vector2i findClosestFloor(const Vector2i& position) const;
+	Vector2i searchClosestFloor(const Vector2i& start) const;
+	void computeClosestFloors(const Vector2i& chunk);
+	void rebuildHulls(const Vector2i& chunk);
+	Vector2i toChunk(const Vector2i& tile) const;
+	sf::IntRect getChunkArea(const Vector2i& chunk) const;
+	bool isFloor(const Vector2i& position) const;
 	std::vector<Vector2i> createMinimalSpanningTree(
 			const Vector2i& start, const float limit);
-	void connectRooms(const Vector2i& start);
+	std::vector<Vector2i> connectRooms(const Vector2i& start);
 	std::vector<Vector2f> getEnemySpawns(const sf::IntRect& area);
-	void draw(sf::RenderTarget& target, sf::RenderStates states) const;
+	void draw(sf::RenderTarget& target, sf::RenderStates states) const;
+	void applyConfig(const GeneratorConfig& config);
 
 private:
+	static const std::string CONFIG_NAME;
+	/// Not changed on reload, as it determines the chunks that were
+	/// already generated.
 	const int mAreaSize;
-	const float mMaxRange;
-	const float mRoomSizeValue;
-	const float mRoomConnectionValue;
-	const float mEnemyGenerationChance;
+	float mMaxRange;
+	float mRoomSizeValue;
+	float mRoomConnectionValue;
+	float mEnemyGenerationChance;
+	/// True to use generateMergedAreas instead of generateAreas.
+	bool mMergeAreas;
+	/// Id of the ConfigWatcher subscription for CONFIG_NAME.
+	int mConfigSubscription;
 
 	World& mWorld;
 	Pathfinder& mPathfinder;
@@ -58,11 +106,12 @@ private:
 	array mTiles;
 	/// Stores where tiles have already been generated.
 	std::map<int, std::map<int, bool> > mGenerated;
+	/// Data for generated areas, by area (not tile) coordinates.
+	std::map<Vector2i, Chunk> mChunks;
 	/// Perlin noise used for tile generation.
 	SimplexNoise mTileNoise;
 	/// Perlin noise used for character placement.
 	SimplexNoise mCharacterNoise;
-	std::vector<ltbl::ConvexHull*> mHulls;
 	/// Used only for debug drawing.
 	std::vector<std::vector<Vector2i> > mPaths;
 };
@@ -0,0 +1,119 @@
+/*
+ * LocalGrid.h
+ *
+ *  Created on: 19.10.2026
+ */
+
+#ifndef DG_LOCALGRID_H_
+#define DG_LOCALGRID_H_
+
+#include <vector>
+
+#include "../util/Vector.h"
+
+/**
+ * Flat array of values for integer points around a center, used instead of
+ * std::map/std::set for searches during generation.
+ *
+ * The covered square starts around the center and doubles its side length
+ * whenever a point outside of it is written, so searches that stay close
+ * to their start only need a single small allocation.
+ *
+ * @code
+ * LocalGrid<char> visited(start, 4, false);
+ * visited[Vector2i(3, 5)] = true;
+ * @endcode
+ */
+template <typename T>
+class LocalGrid {
+public:
+	explicit LocalGrid(const Vector2i& center, int radius, const T& defaultValue);
+
+	T& operator[](const Vector2i& point);
+	T get(const Vector2i& point) const;
+	bool contains(const Vector2i& point) const;
+
+private:
+	void grow(const Vector2i& point);
+
+private:
+	Vector2i mOrigin; //< Smallest point that is contained.
+	int mSize; //< Side length of the covered square.
+	T mDefault;
+	std::vector<T> mValues; //< Values in row major order.
+};
+
+/**
+ * @param center Point around which values are expected.
+ * @param radius Initial number of points covered in each direction.
+ * @param defaultValue Value of each point that has not been written yet.
+ */
+template <typename T>
+LocalGrid<T>::LocalGrid(const Vector2i& center, int radius,
+		const T& defaultValue) :
+		mOrigin(center.x - radius, center.y - radius),
+		mSize(2 * radius + 1),
+		mDefault(defaultValue),
+		mValues(mSize * mSize, defaultValue) {
+}
+
+/**
+ * Returns a reference to the value at point, growing the grid if needed.
+ *
+ * @warning References are invalidated when the grid grows.
+ */
+template <typename T>
+T&
+LocalGrid<T>::operator[](const Vector2i& point) {
+	if (!contains(point))
+		grow(point);
+	return mValues[(point.y - mOrigin.y) * mSize + point.x - mOrigin.x];
+}
+
+/**
+ * Returns the value at point, or the default value if it was never written.
+ */
+template <typename T>
+T
+LocalGrid<T>::get(const Vector2i& point) const {
+	return (contains(point))
+			? mValues[(point.y - mOrigin.y) * mSize + point.x - mOrigin.x]
+			: mDefault;
+}
+
+/**
+ * Returns true if point lies within the currently allocated square.
+ */
+template <typename T>
+bool
+LocalGrid<T>::contains(const Vector2i& point) const {
+	return point.x >= mOrigin.x && point.x < mOrigin.x + mSize &&
+			point.y >= mOrigin.y && point.y < mOrigin.y + mSize;
+}
+
+/**
+ * Doubles the side length (keeping the old square centered) until point
+ * is contained, and copies the old values over.
+ */
+template <typename T>
+void
+LocalGrid<T>::grow(const Vector2i& point) {
+	Vector2i origin = mOrigin;
+	int size = mSize;
+	while (point.x < origin.x || point.x >= origin.x + size ||
+			point.y < origin.y || point.y >= origin.y + size) {
+		origin -= Vector2i(size / 2 + 1, size / 2 + 1);
+		size = size * 2 + 2;
+	}
+
+	std::vector<T> values(size * size, mDefault);
+	for (int y = 0; y < mSize; y++)
+		for (int x = 0; x < mSize; x++)
+			values[(y + mOrigin.y - origin.y) * size + x + mOrigin.x - origin.x] =
+					mValues[y * mSize + x];
+	mOrigin = origin;
+	mSize = size;
+	mValues.swap(values);
+}
+
+#endif /* DG_LOCALGRID_H_ */
@@ -8,8 +8,161 @@
 #include "SimplexNoise.h"
 
 #include <algorithm>
+#include <random>
 #include <time.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+const float F2 = 0.366025403f; // F2 = 0.5*(sqrt(3.0)-1.0)
+const float G2 = 0.211324865f; // G2 = (3.0-Math.sqrt(3.0))/6.0
+
+#if defined(__AVX2__)
+
+typedef __m256 Floats;
+typedef __m256i Ints;
+const int LANES = 8;
+
+inline Floats setf(float f) {return _mm256_set1_ps(f);}
+inline Ints seti(int i) {return _mm256_set1_epi32(i);}
+inline Floats laneOffsets() {return _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);}
+inline void store(float* p, Floats f) {_mm256_storeu_ps(p, f);}
+inline void storei(int* p, Ints i) {_mm256_store_si256((Ints*) p, i);}
+inline Ints loadi(const int* p) {return _mm256_load_si256((const Ints*) p);}
+inline Floats add(Floats a, Floats b) {return _mm256_add_ps(a, b);}
+inline Floats sub(Floats a, Floats b) {return _mm256_sub_ps(a, b);}
+inline Floats mul(Floats a, Floats b) {return _mm256_mul_ps(a, b);}
+inline Floats max(Floats a, Floats b) {return _mm256_max_ps(a, b);}
+inline Floats andf(Floats a, Floats b) {return _mm256_and_ps(a, b);}
+inline Floats xorf(Floats a, Floats b) {return _mm256_xor_ps(a, b);}
+inline Floats greater(Floats a, Floats b) {return _mm256_cmp_ps(a, b, _CMP_GT_OQ);}
+inline Floats select(Floats mask, Floats a, Floats b) {return _mm256_blendv_ps(b, a, mask);}
+inline Floats toFloats(Ints i) {return _mm256_cvtepi32_ps(i);}
+inline Ints truncate(Floats f) {return _mm256_cvttps_epi32(f);}
+inline Floats asFloats(Ints i) {return _mm256_castsi256_ps(i);}
+inline Ints asInts(Floats f) {return _mm256_castps_si256(f);}
+inline Ints addi(Ints a, Ints b) {return _mm256_add_epi32(a, b);}
+inline Ints subi(Ints a, Ints b) {return _mm256_sub_epi32(a, b);}
+inline Ints andi(Ints a, Ints b) {return _mm256_and_si256(a, b);}
+inline Ints equali(Ints a, Ints b) {return _mm256_cmpeq_epi32(a, b);}
+template <int N> inline Ints shifti(Ints i) {return _mm256_slli_epi32(i, N);}
+
+#elif defined(__SSE2__)
+
+typedef __m128 Floats;
+typedef __m128i Ints;
+const int LANES = 4;
+
+inline Floats setf(float f) {return _mm_set1_ps(f);}
+inline Ints seti(int i) {return _mm_set1_epi32(i);}
+inline Floats laneOffsets() {return _mm_setr_ps(0, 1, 2, 3);}
+inline void store(float* p, Floats f) {_mm_storeu_ps(p, f);}
+inline void storei(int* p, Ints i) {_mm_store_si128((Ints*) p, i);}
+inline Ints loadi(const int* p) {return _mm_load_si128((const Ints*) p);}
+inline Floats add(Floats a, Floats b) {return _mm_add_ps(a, b);}
+inline Floats sub(Floats a, Floats b) {return _mm_sub_ps(a, b);}
+inline Floats mul(Floats a, Floats b) {return _mm_mul_ps(a, b);}
+inline Floats max(Floats a, Floats b) {return _mm_max_ps(a, b);}
+inline Floats andf(Floats a, Floats b) {return _mm_and_ps(a, b);}
+inline Floats xorf(Floats a, Floats b) {return _mm_xor_ps(a, b);}
+inline Floats greater(Floats a, Floats b) {return _mm_cmpgt_ps(a, b);}
+inline Floats select(Floats mask, Floats a, Floats b) {
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+inline Floats toFloats(Ints i) {return _mm_cvtepi32_ps(i);}
+inline Ints truncate(Floats f) {return _mm_cvttps_epi32(f);}
+inline Floats asFloats(Ints i) {return _mm_castsi128_ps(i);}
+inline Ints asInts(Floats f) {return _mm_castps_si128(f);}
+inline Ints addi(Ints a, Ints b) {return _mm_add_epi32(a, b);}
+inline Ints subi(Ints a, Ints b) {return _mm_sub_epi32(a, b);}
+inline Ints andi(Ints a, Ints b) {return _mm_and_si128(a, b);}
+inline Ints equali(Ints a, Ints b) {return _mm_cmpeq_epi32(a, b);}
+template <int N> inline Ints shifti(Ints i) {return _mm_slli_epi32(i, N);}
+
+#endif
+
+#if defined(__AVX2__) || defined(__SSE2__)
+
+/**
+ * Vectorized SimplexNoise::fastFloor. The comparison mask is -1 for positive
+ * values, so subtracting it undoes the decrement for those.
+ */
+inline Ints fastFloor(Floats f) {
+	return subi(addi(truncate(f), seti(-1)), asInts(greater(f, setf(0.0f))));
+}
+
+/**
+ * Vectorized SimplexNoise::grad. Negation is done by flipping the sign bit.
+ */
+inline Floats grad(Ints hash, Floats x, Floats y) {
+	Floats lowHash = asFloats(equali(andi(hash, seti(4)), seti(0)));
+	Floats u = select(lowHash, x, y);
+	Floats v = select(lowHash, y, x);
+	u = xorf(u, asFloats(shifti<31>(andi(hash, seti(1)))));
+	v = xorf(add(v, v), asFloats(shifti<30>(andi(hash, seti(2)))));
+	return add(u, v);
+}
+
+/**
+ * Returns the contribution of a single simplex corner.
+ */
+inline Floats corner(Ints hash, Floats x, Floats y) {
+	Floats t = max(sub(sub(setf(0.5f), mul(x, x)), mul(y, y)), setf(0.0f));
+	t = mul(t, t);
+	return mul(mul(t, t), grad(hash, x, y));
+}
+
+/**
+ * Vectorized SimplexNoise::noise for the points (x, y) to (x + LANES - 1, y).
+ *
+ * Permutation lookups can't be vectorized (bytes can't be gathered), so
+ * these are done per lane.
+ */
+Floats noiseLanes(const unsigned char* perm, int x, int y) {
+	Floats xv = add(setf(x), laneOffsets());
+	Floats yv = setf(y);
+
+	Floats s = mul(add(xv, yv), setf(F2));
+	Ints i = fastFloor(add(xv, s));
+	Ints j = fastFloor(add(yv, s));
+
+	Floats t = mul(toFloats(addi(i, j)), setf(G2));
+	Floats x0 = sub(xv, sub(toFloats(i), t));
+	Floats y0 = sub(yv, sub(toFloats(j), t));
+
+	Floats lowerTriangle = greater(x0, y0);
+	Floats i1 = andf(lowerTriangle, setf(1.0f));
+	Floats j1 = sub(setf(1.0f), i1);
+
+	Floats x1 = add(sub(x0, i1), setf(G2));
+	Floats y1 = add(sub(y0, j1), setf(G2));
+	Floats x2 = add(sub(x0, setf(1.0f)), setf(2.0f * G2));
+	Floats y2 = add(sub(y0, setf(1.0f)), setf(2.0f * G2));
+
+	alignas(32) int ii[LANES], jj[LANES], ii1[LANES];
+	alignas(32) int gi0[LANES], gi1[LANES], gi2[LANES];
+	storei(ii, andi(i, seti(0xff)));
+	storei(jj, andi(j, seti(0xff)));
+	storei(ii1, andi(asInts(lowerTriangle), seti(1)));
+	for (int l = 0; l < LANES; l++) {
+		int jj1 = 1 - ii1[l];
+		gi0[l] = perm[ii[l] + perm[jj[l]]];
+		gi1[l] = perm[ii[l] + ii1[l] + perm[jj[l] + jj1]];
+		gi2[l] = perm[ii[l] + 1 + perm[jj[l] + 1]];
+	}
+
+	Floats n = add(add(corner(loadi(gi0), x0, y0), corner(loadi(gi1), x1, y1)),
+			corner(loadi(gi2), x2, y2));
+	return mul(setf(40.0f), n);
+}
+
+#endif
+}
+
 /**
  * Initializes permutation with random values.
  */
@@ -22,24 +175,35 @@ SimplexNoise::SimplexNoise() {
 }
 
 /**
- * Returns a noise value from cache, or generates if it was requested for
- * the first time.
+ * Generates the noise value for a single point.
  *
  * @return Value within [-1, 1]
  */
 float
-SimplexNoise::getNoise(int x, int y) {
-	if (mCache.count(x) == 0 ||
-			mCache.at(x).count(y) == 0)
-		mCache[x][y] = noise(x, y);
-	return mCache.at(x).at(y);
+SimplexNoise::getNoise(int x, int y) const {
+	return noise(x, y);
 }
 
 float
-SimplexNoise::getNoise(const Vector2i& v) {
+SimplexNoise::getNoise(const Vector2i& v) const {
 	return getNoise(v.x, v.y);
 }
 
+/**
+ * Generates noise values for every integer point in area.
+ *
+ * @return Values within [-1, 1], in row major order (index is
+ * 		   (y - area.top) * area.width + (x - area.left)).
+ */
+std::vector<float>
+SimplexNoise::getNoise(const sf::IntRect& area) const {
+	std::vector<float> values(area.width * area.height);
+	for (int y = 0; y < area.height; y++)
+		noiseRow(area.left, area.top + y, area.width,
+				&values[y * area.width]);
+	return values;
+}
+
 /**
  * Floor implementation that is faster than std implementation by
  * ignoring some checks and does not consider some border conditions.
@@ -68,9 +232,6 @@ SimplexNoise::grad(int hash, float x, float y) const {
 float
 SimplexNoise::noise(float x, float y) const {
 
-#define F2 0.366025403 // F2 = 0.5*(sqrt(3.0)-1.0)
-#define G2 0.211324865 // G2 = (3.0-Math.sqrt(3.0))/6.0
-
     float n0, n1, n2; // Noise contributions from the three corners
 
     // Skew the input space to determine which simplex cell we're in
@@ -131,3 +292,18 @@ SimplexNoise::noise(float x, float y) const {
     // The result is scaled to return values in the interval [-1,1].
     return 40.0f * (n0 + n1 + n2);
   }
+
+/**
+ * Writes noise values for the points (x, y) to (x + count - 1, y) into values,
+ * using vector instructions where possible.
+ */
+void
+SimplexNoise::noiseRow(int x, int y, int count, float* values) const {
+	int i = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+	for (; i + LANES <= count; i += LANES)
+		store(values + i, noiseLanes(mPerm.data(), x + i, y));
+#endif
+	for (; i < count; i++)
+		values[i] = noise(x + i, y);
+}
@@ -9,12 +9,19 @@
 #define DG_SIMPLEXNOISE_H_
 
 #include <array>
-#include <map>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
 
 #include "../util/Vector.h"
 
 /**
- * Caching simplex noise generator.
+ * Simplex noise generator.
+ *
+ * Values are not cached, as recomputing 2D simplex noise is cheaper than
+ * looking it up in a tree. Use getNoise(const sf::IntRect&) to evaluate
+ * an entire area at once, which uses SSE2 or AVX2 if those are enabled
+ * at compile time (eg. -msse2 or -mavx2), and scalar code otherwise.
  *
  * The actual simplex noise generator is simplexnoise1234.h/cpp
  * from http://staffwww.itn.liu.se/~stegu/aqsis/aqsis-newnoise/ . See
@@ -23,18 +30,18 @@
 class SimplexNoise {
 public:
     SimplexNoise();
-    float getNoise(int x, int y);
-    float getNoise(const Vector2i& v);
-
+    float getNoise(int x, int y) const;
+    float getNoise(const Vector2i& v) const;
+    std::vector<float> getNoise(const sf::IntRect& area) const;
 
 private:
     float noise(float x, float y) const;
     float grad(int hash, float x, float y) const;
     int fastFloor(float f) const;
+    void noiseRow(int x, int y, int count, float* values) const;
 
 private:
     std::array<unsigned char, 512> mPerm;
-    std::map<int, std::map<int, float> > mCache;
 };
 
 #endif /* DG_SIMPLEXNOISE_H_ */
@@ -6,7 +6,10 @@
  */
 
 #include "Game.h"
+#include "util/ConfigWatcher.h"
 #include "util/Loader.h"
+#include "util/Preloader.h"
+#include "util/Trace.h"
 #include "util/Yaml.h"
 #include "util/Log.h"
 
@@ -14,11 +17,26 @@
 
 /**
  * Creates Game object.
+ *
+ * Pass "--trace <file>" to record gameplay events into file, see Trace.
  */
 int main(int argc, char* argv[]) {
+	// Created first so that it is destroyed last, after anything that logs.
+	Logger::i();
+	sf::Clock startup;
 	Yaml::setFolder("res/yaml/");
+	// Created by tools/ConfigCompiler, YAML files are parsed if it is missing.
+	// Development builds always parse them, so that edits are never hidden
+	// by an outdated bundle.
+#ifdef RELEASE
+	bool bundle = Yaml::loadBundle("res/config.bundle");
+#else
+	bool bundle = false;
+	ConfigWatcher::i().start("res/yaml/");
+#endif
 	Loader::i().setFolder("res/");
 	Loader::i().setSubFolder<sf::Texture>("textures/");
+	Loader::i().setSubFolder<sf::Image>("textures/");
 
 	Yaml windowConfig("window.yaml");
 	sf::VideoMode mode(windowConfig.get("resolution_width", 800),
@@ -35,12 +53,24 @@ int main(int argc, char* argv[]) {
 
     Vector2f::SCREEN_HEIGHT = window.getSize().y;
 
+	// Needs the window for uploading textures.
+	Preloader preloader("preload.yaml", "res/textures/");
+	preloader.addImages(World::getAtlasFiles());
+	preloader.run();
+
 	if (!window.globalFont.loadFromFile("res/DejaVuSans.ttf"))
 		LOG_W("Failed to load font at 'res/DejaVuSans.ttf'");
 
+	for (int i = 1; i + 1 < argc; i++)
+		if (std::string(argv[i]) == "--trace")
+			Trace::i().start(argv[i + 1]);
+
     Game game(window);
+    LOG_I("Startup took " << startup.getElapsedTime().asMilliseconds() <<
+    		" ms, configs " << ((bundle) ? "read from bundle" : "parsed from YAML"));
 
 	game.loop();
+	Trace::i().stop();
 
     return 0;
 }
@@ -7,9 +7,10 @@
 
 #include "Corpse.h"
 
-#include "../util/Yaml.h"
+#include "../util/Config.h"
 
 Corpse::Corpse(const Vector2f& position) :
-		Circle(position, CATEGORY_DECORATION, MASK_NONE, Yaml("corpse.yaml")) {
+		Circle(position, CATEGORY_DECORATION, MASK_NONE,
+				*loadConfig<SpriteConfig>("corpse.yaml")) {
 }
 
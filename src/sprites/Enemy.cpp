@@ -13,7 +13,6 @@
 #include "items/RingOfFire.h"
 #include "items/Shield.h"
 #include "items/Weapon.h"
-#include "../util/Yaml.h"
 
 /**
  * Determines items used by this enemy using seed.
@@ -22,7 +21,7 @@
  */
 Enemy::Enemy(World& world, Pathfinder& pathfinder,
 		const Vector2f& position, const EquippedItems& playerItems) :
-		Character(position, CATEGORY_ACTOR, MASK_ALL, Yaml("enemy.yaml"), world,
+		Character(position, CATEGORY_ACTOR, MASK_ALL, "enemy.yaml", world,
 				pathfinder, generateItems(playerItems)) {
 }
 
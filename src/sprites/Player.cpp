@@ -10,14 +10,13 @@
 #include <Thor/Vectors.hpp>
 
 #include "items/Weapon.h"
-#include "../util/Yaml.h"
 
 /**
  * Initializes Sprite.
  */
 Player::Player(World& world, Pathfinder& pathfinder,
 		const Vector2f& position, const EquippedItems& items) :
-	Character(position, CATEGORY_ACTOR, MASK_ALL, Yaml("player.yaml"), world,
+	Character(position, CATEGORY_ACTOR, MASK_ALL, "player.yaml", world,
 			pathfinder, items) {
 }
 
@@ -7,9 +7,9 @@
 
 #include "RotatingShield.h"
 
-#include "../util/Yaml.h"
+#include "../util/Config.h"
 
 RotatingShield::RotatingShield(const Vector2f& position) :
 		Rectangle(position, CATEGORY_WORLD, MASK_ALL,
-				Yaml("rotating_shield.yaml")) {
+				*loadConfig<SpriteConfig>("rotating_shield.yaml")) {
 }
@@ -10,45 +10,46 @@
 #include <Thor/Vectors.hpp>
 
 #include "../util/Interval.h"
-#include "../util/Loader.h"
-#include "../util/Yaml.h"
 #include "../World.h"
 
 const Vector2i Tile::TILE_SIZE = Vector2i(75, 75);
 
+const ConfigFields<TileConfig>&
+TileConfig::getFields() {
+	static const ConfigFields<TileConfig> fields = ConfigFields<TileConfig>()
+			.add("size", &TileConfig::size)
+			.add("texture", &TileConfig::texture)
+			.addTexture("texture", &TileConfig::textureId);
+	return fields;
+}
+
 /**
- * Constructs a tile. Use this over setTile if a tile has not been generated
- * for the position yet.
+ * Constructs a tile. Use setTile instead to insert tiles into the world.
  *
  * @param pType Type of the tile to create.
  */
 Tile::Tile(const Vector2i& tilePosition, Type type) :
 		Rectangle(toPosition(tilePosition),
 				CATEGORY_WORLD,	(isSolid(type)) ? 0xffff : 0,
-				Yaml(getConfig(type))),	mType(type) {
+				loadConfig<TileConfig>(getConfig(type))->size,
+				loadConfig<TileConfig>(getConfig(type))->textureId),
+		mType(type),
+		mTilePosition(tilePosition) {
 }
 
 /**
- * Places a tile of type at position, removing an old tile of different type
- * if one exists.
- *
- * Highly inefficient as World::getNearbySprites has to be searched for every call.
+ * Places a tile of type at position. If a tile already exists there, its
+ * type is changed instead of creating a new one.
  */
 void
 Tile::setTile(const Vector2i& position, Type type, World& world) {
-	Vector2f worldPosition(thor::cwiseProduct(position, TILE_SIZE));
-	auto candidates = world.getNearbySprites(worldPosition, 1.0f);
-	for (auto& c : candidates) {
-		std::shared_ptr<Tile> converted = std::dynamic_pointer_cast<Tile>(c);
-		// Direct comparison of floats as both are from the same generation
-		// on the same CPU.
-		if (converted && converted->getPosition() == worldPosition &&
-				converted->getType() != type) {
-			world.remove(converted);
-			break;
-		}
+	std::shared_ptr<Tile> tile = world.getTile(position);
+	if (!tile)
+		world.insertTile(std::make_shared<Tile>(position, type));
+	else if (tile->getType() != type) {
+		tile->setType(type);
+		world.updateTile(*tile);
 	}
-	world.insert(std::shared_ptr<Sprite>(new Tile(position, type)));
 }
 
 /**
@@ -66,6 +67,14 @@ Tile::getConfig(Type type) {
 	}
 }
 
+/**
+ * Returns the texture file name for the tile type.
+ */
+std::string
+Tile::getTexture(Type type) {
+	return loadConfig<TileConfig>(getConfig(type))->texture;
+}
+
 /**
  * Returns true if collisions with this tile type are enabled.
  */
@@ -96,3 +105,21 @@ Tile::Type
 Tile::getType() const {
 	return mType;
 }
+
+/**
+ * Returns the position of this tile in tile coordinates.
+ */
+Vector2i
+Tile::getTilePosition() const {
+	return mTilePosition;
+}
+
+/**
+ * Changes type, texture and collisions of this tile.
+ */
+void
+Tile::setType(Type type) {
+	mType = type;
+	setMask((isSolid(type)) ? 0xffff : 0);
+	setTexture(loadConfig<TileConfig>(getConfig(type))->textureId);
+}
@@ -9,9 +9,22 @@
 #define DG_TILE_H_
 
 #include "abstract/Rectangle.h"
+#include "../util/Config.h"
 
 class World;
 
+/**
+ * Values of a tile type, read from its YAML file.
+ */
+struct TileConfig {
+	Vector2f size;
+	/// File name, to pack the texture into World's atlas.
+	std::string texture;
+	Loader::ResourceId textureId;
+
+	static const ConfigFields<TileConfig>& getFields();
+};
+
 /**
  * Holds information about a single tile.
  */
@@ -26,14 +39,20 @@ public:
 public:
 	explicit Tile(const Vector2i& tilePosition, Type type);
 	Type getType() const;
+	Vector2i getTilePosition() const;
 
 	static void setTile(const Vector2i& position, Type type, World& world);
 	static std::string getConfig(Type type);
+	static std::string getTexture(Type type);
 	static bool isSolid(Type type);
 	static Vector2f toPosition(const Vector2i& tilePosition);
 
+private:
+	void setType(Type type);
+
 private:
 	Type mType;
+	const Vector2i mTilePosition;
 };
 
 #endif /* DG_TILE_H_ */
@@ -12,26 +12,56 @@
 #include "../items/HealthOrb.h"
 #include "../items/Weapon.h"
 #include "../Corpse.h"
+#include "../../util/ConfigWatcher.h"
 #include "../../util/Log.h"
-#include "../../util/Yaml.h"
+#include "../../util/Trace.h"
 #include "../../World.h"
 #include "../../Pathfinder.h"
 
+const ConfigFields<CharacterConfig>&
+CharacterConfig::getFields() {
+	static const ConfigFields<CharacterConfig> fields = ConfigFields<CharacterConfig>()
+			.add("size", &CharacterConfig::size)
+			.addTexture("texture", &CharacterConfig::texture)
+			.add("health", &CharacterConfig::health)
+			.add("speed", &CharacterConfig::speed)
+			.add("faction", &CharacterConfig::faction);
+	return fields;
+}
+
 /**
  * Saves pointer to this instance in static var for think().
+ *
+ * @param config File name of the CharacterConfig. Health and speed are
+ * 				 updated when it is reloaded.
+ */
+Character::Character(const Vector2f& position, Category category,
+		unsigned short mask, const std::string& config, World& world,
+		Pathfinder& pathfinder, const EquippedItems& items) :
+		Character(position, category, mask, config,
+				loadConfig<CharacterConfig>(config), world, pathfinder, items) {
+}
+
+/**
+ * @param loaded The CharacterConfig from config, so it is only looked up
+ * 				 once.
  */
 Character::Character(const Vector2f& position, Category category,
-		unsigned short mask, const Yaml& config, World& world,
+		unsigned short mask, const std::string& config,
+		std::shared_ptr<const CharacterConfig> loaded, World& world,
 		Pathfinder& pathfinder, const EquippedItems& items) :
-		Circle(position, category, mask, config),
+		Circle(position, category, mask, loaded->size, loaded->texture),
 		mWorld(world),
 		mPathfinder(pathfinder),
-		mMaxHealth(config.get("health", 100)),
+		mMaxHealth(loaded->health),
 		mHealth(mMaxHealth),
-		mMovementSpeed(config.get("speed", 0.0f)),
+		mMovementSpeed(loaded->speed),
 		mActiveWeapon(mFirstWeapon),
 		mLastPosition(getPosition()),
-		mFaction((Faction) config.get("faction", 1)) {
+		mFaction((Faction) loaded->faction) {
+	 mConfigSubscription = ConfigWatcher::i().subscribe(config, [this, config]() {
+		 applyConfig(*loadConfig<CharacterConfig>(config));
+	 });
 	 setFirstWeapon(Weapon::getWeapon(world, *this, items.primary));
 	 setSecondWeapon(Weapon::getWeapon(world, *this, items.secondary));
 	 setLeftGadget(Gadget::getGadget(world, items.left));
@@ -39,6 +69,18 @@ Character::Character(const Vector2f& position, Category category,
 }
 
 Character::~Character() {
+	ConfigWatcher::i().unsubscribe(mConfigSubscription);
+}
+
+/**
+ * Takes maximum health and movement speed from config. Health is reduced
+ * if it exceeds the new maximum.
+ */
+void
+Character::applyConfig(const CharacterConfig& config) {
+	mMaxHealth = config.health;
+	mHealth = std::min(mHealth, mMaxHealth);
+	mMovementSpeed = config.speed;
 }
 
 /**
@@ -57,8 +99,10 @@ Character::onDamage(int damage) {
 
 	if (mHealth > mMaxHealth)
 		mHealth = mMaxHealth;
+	Trace::record(Trace::DAMAGE, getId(), 0, damage, mHealth);
 
 	if (mHealth <= 0) {
+		Trace::record(Trace::DEATH, getId(), 0, getPosition().x, getPosition().y);
 		onDeath();
 		setDelete(true);
 	}
@@ -102,8 +146,8 @@ void Character::dropItem(std::shared_ptr<Item> item) {
 	if (weapon)
 		weapon->releaseTrigger();
 
-	mWorld.insert(item);
 	item->drop(getPosition());
+	mWorld.insert(item);
 }
 
 /**
@@ -347,16 +391,16 @@ Character::pickUpItem() {
 	auto orb = std::dynamic_pointer_cast<HealthOrb>(closest);
 
 	if (weapon) {
-		mWorld.insert(mActiveWeapon);
 		mActiveWeapon->drop(getPosition());
+		mWorld.insert(mActiveWeapon);
 		(mActiveWeapon == mFirstWeapon)
 				? setFirstWeapon(weapon)
 				: setSecondWeapon(weapon);
 	}
 	else if (gadget) {
 		if (mRightGadget) {
-			mWorld.insert(mRightGadget);
 			mRightGadget->drop(getPosition());
+			mWorld.insert(mRightGadget);
 		}
 		mRightGadget = mLeftGadget;
 		mLeftGadget = gadget;
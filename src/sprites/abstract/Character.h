@@ -12,10 +12,24 @@
 
 #include "../items/Gadget.h"
 #include "../items/Weapon.h"
+#include "../../util/Config.h"
 
 class Pathfinder;
 class World;
-class Yaml;
+
+/**
+ * Values of a character type, read from its YAML file.
+ */
+struct CharacterConfig {
+	Vector2f size;
+	Loader::ResourceId texture;
+	int health = 100;
+	/// Movement speed in pixels per second.
+	float speed = 0;
+	int faction = 1;
+
+	static const ConfigFields<CharacterConfig>& getFields();
+};
 
 /**
  * Provides think function for AI, manages health, drops body on death.
@@ -42,7 +56,7 @@ public:
 
 public:
 	explicit Character(const Vector2f& position, Category category,
-			unsigned short mask, const Yaml& config, World& world,
+			unsigned short mask, const std::string& config, World& world,
 			Pathfinder& pathfinder, const EquippedItems& items);
 	virtual ~Character() = 0;
 
@@ -80,8 +94,13 @@ protected:
 	void pickUpItem();
 
 private:
+	explicit Character(const Vector2f& position, Category category,
+			unsigned short mask, const std::string& config,
+			std::shared_ptr<const CharacterConfig> loaded, World& world,
+			Pathfinder& pathfinder, const EquippedItems& items);
 	void move();
 	void dropItem(std::shared_ptr<Item> item);
+	void applyConfig(const CharacterConfig& config);
 
 private:
 	friend class Shield;
@@ -93,9 +112,9 @@ private:
 	World& mWorld;
 	Pathfinder& mPathfinder;
 
-	const int mMaxHealth;
+	int mMaxHealth;
 	int mHealth; //< Current health. Between 0 and mMaxHealth.
-	const float mMovementSpeed;
+	float mMovementSpeed;
 	std::shared_ptr<Weapon> mFirstWeapon;
 	std::shared_ptr<Weapon> mSecondWeapon;
 	std::shared_ptr<Weapon> mActiveWeapon;
@@ -104,6 +123,8 @@ private:
 	std::vector<Vector2f> mPath; //< Contains nodes to reach a set destination.
 	Vector2f mLastPosition;
 	Faction mFaction;
+	/// Id of the ConfigWatcher subscription for the config file.
+	int mConfigSubscription;
 };
 
 #endif /* DG_ACTOR_H_ */
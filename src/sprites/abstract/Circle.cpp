@@ -8,13 +8,17 @@
 #include "Circle.h"
 
 #include "Rectangle.h"
-#include "../../util/Yaml.h"
 
 Circle::Circle(const Vector2f& position, Category category,
-			unsigned short mask, const Yaml& config,
+			unsigned short mask, const SpriteConfig& config,
 			const Vector2f& direction) :
-	Sprite(position, category, mask, config.get("size", Vector2f()),
-			config.get("texture", std::string()), direction) {
+	Sprite(position, category, mask, config.size, config.texture, direction) {
+}
+
+Circle::Circle(const Vector2f& position, Category category,
+			unsigned short mask, const Vector2f& size,
+			Loader::ResourceId texture, const Vector2f& direction) :
+	Sprite(position, category, mask, size, texture, direction) {
 }
 
 /**
@@ -43,5 +47,5 @@ Circle::testCollision(std::shared_ptr<Sprite> other,
  */
 float
 Circle::getRadius() const {
-	return getSize().x / 2;
+	return getHalfSize().x;
 }
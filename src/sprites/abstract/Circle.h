@@ -11,15 +11,17 @@
 #include "CollisionModel.h"
 #include "Sprite.h"
 
-class Yaml;
-
 /**
  * Shape that uses a circle as collision model.
  */
 class Circle : public CollisionModel, public Sprite {
 public:
 	explicit Circle(const Vector2f& position, Category category,
-			unsigned short mask, const Yaml& config,
+			unsigned short mask, const SpriteConfig& config,
+			const Vector2f& direction = Vector2f(0, 0));
+	explicit Circle(const Vector2f& position, Category category,
+			unsigned short mask, const Vector2f& size,
+			Loader::ResourceId texture,
 			const Vector2f& direction = Vector2f(0, 0));
 	virtual ~Circle() = default;
 
@@ -30,7 +30,7 @@ CollisionModel::~CollisionModel() {
 bool
 CollisionModel::testCollision(const Circle& circle, const Rectangle& rect,
 		Vector2f& offsetFirst, const Vector2f& offsetSecond) {
-	Vector2f halfSize = rect.getSize() / 2.0f;
+	Vector2f halfSize = rect.getHalfSize();
 	Vector2f rectNewPos = rect.getPosition() + offsetSecond;
 	Vector2f circleRotatedPos = circle.getPosition() + offsetFirst - rectNewPos;
 	circleRotatedPos = thor::rotatedVector(circleRotatedPos, -rect.mShape.getRotation());
@@ -8,13 +8,17 @@
 #include "Rectangle.h"
 
 #include "Circle.h"
-#include "../../util/Yaml.h"
 
 Rectangle::Rectangle(const Vector2f& position, Category category,
-		unsigned short mask, const Yaml& config,
+		unsigned short mask, const SpriteConfig& config,
 		const Vector2f& direction) :
-	Sprite(position, category, mask, config.get("size", Vector2f()),
-			config.get("texture", std::string()), direction) {
+	Sprite(position, category, mask, config.size, config.texture, direction) {
+}
+
+Rectangle::Rectangle(const Vector2f& position, Category category,
+			unsigned short mask, const Vector2f& size,
+			Loader::ResourceId texture, const Vector2f& direction) :
+	Sprite(position, category, mask, size, texture, direction) {
 }
 
 /**
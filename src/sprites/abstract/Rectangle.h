@@ -11,15 +11,17 @@
 #include "CollisionModel.h"
 #include "Sprite.h"
 
-class Yaml;
-
 /**
  * Shape that uses an axis aligned Rectangle as a collision model.
  */
 class Rectangle : public CollisionModel, public Sprite {
 public:
 	explicit Rectangle(const Vector2f& position, Category category,
-			unsigned short mask, const Yaml& config,
+			unsigned short mask, const SpriteConfig& config,
+			const Vector2f& direction = sf::Vector2f(0, 0));
+	explicit Rectangle(const Vector2f& position, Category category,
+			unsigned short mask, const Vector2f& size,
+			Loader::ResourceId texture,
 			const Vector2f& direction = sf::Vector2f(0, 0));
 	virtual ~Rectangle() = default;
 
@@ -9,12 +9,25 @@
 
 #include <Thor/Vectors.hpp>
 
-#include "../../util/Loader.h"
+#include "../../BodyStore.h"
+#include "../../World.h"
 #include "../../util/Log.h"
 
+unsigned int Sprite::mNextId = 1;
+
+const ConfigFields<SpriteConfig>&
+SpriteConfig::getFields() {
+	static const ConfigFields<SpriteConfig> fields = ConfigFields<SpriteConfig>()
+			.add("size", &SpriteConfig::size)
+			.addTexture("texture", &SpriteConfig::texture);
+	return fields;
+}
+
 Sprite::Sprite(const Vector2f& position, Category category,
 			unsigned short mask, const Vector2f& size,
-			const std::string& texture,	const Vector2f& direction) :
+			Loader::ResourceId texture, const Vector2f& direction) :
+			mId(mNextId++),
+			mHalfSize(size / 2.0f),
 			mCategory(category),
 			mMask(mask) {
 	mShape.setSize(size);
@@ -25,12 +38,20 @@ Sprite::Sprite(const Vector2f& position, Category category,
 	setTexture(texture);
 }
 
+/**
+ * Returns an id that identifies this sprite in traces.
+ */
+unsigned int
+Sprite::getId() const {
+	return mId;
+}
+
 /**
  * Returns the position of the sprite (center).
  */
 Vector2f
 Sprite::getPosition() const {
-	return mShape.getPosition();
+	return (mBodies) ? mBodies->getPosition(*this) : mPosition;
 }
 
 /**
@@ -38,7 +59,7 @@ Sprite::getPosition() const {
  */
 Vector2f
 Sprite::getSpeed() const {
-	return mSpeed;
+	return (mBodies) ? mBodies->getSpeed(*this) : mSpeed;
 }
 
 /**
@@ -46,7 +67,7 @@ Sprite::getSpeed() const {
  */
 Vector2f
 Sprite::getDirectionVector() const {
-	return thor::rotatedVector(Vector2f(0, - 1), mShape.getRotation());
+	return mDirection;
 }
 
 float
@@ -76,12 +97,20 @@ Sprite::getCategory() const {
  */
 Vector2f
 Sprite::getSize() const {
-	sf::FloatRect bounds = mShape.getLocalBounds();
-	return Vector2f(bounds.width, bounds.height);
+	return mHalfSize * 2.0f;
+}
+
+/**
+ * Returns half of the size of the sprite, does not consider rotation.
+ */
+Vector2f
+Sprite::getHalfSize() const {
+	return mHalfSize;
 }
 
 void
 Sprite::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+	states.transform.translate(getPosition());
 	target.draw(mShape, states);
 }
 
@@ -90,12 +119,15 @@ Sprite::draw(sf::RenderTarget& target, sf::RenderStates states) const {
  */
 bool
 Sprite::collisionEnabled(Category category) const {
-	return (category & mMask) != 0;
+	return (category & ((mBodies) ? mBodies->getMask(*this) : mMask)) != 0;
 }
 
+/**
+ * Returns true if the bounding box of this sprite intersects rect.
+ */
 bool
 Sprite::isInside(const sf::FloatRect& rect) const {
-	return rect.intersects(mShape.getGlobalBounds());
+	return rect.intersects(sf::FloatRect(getPosition() - mExtent, mExtent * 2.0f));
 }
 
 /**
@@ -113,7 +145,9 @@ Sprite::onCollide(std::shared_ptr<Sprite> other) {
  */
 void
 Sprite::setDelete(bool value) {
-	mDelete = value;
+	mDelete = value;
+	if (mDelete && mContainingWorld)
+		mContainingWorld->wake(*this);
 }
 
 /**
@@ -126,7 +160,12 @@ void
 Sprite::setSpeed(Vector2f direction, float speed) {
 	if (direction != Vector2f())
 		thor::setLength(direction, speed);
-	mSpeed = direction;
+	if (mBodies)
+		mBodies->setSpeed(*this, direction);
+	else
+		mSpeed = direction;
+	if (direction != Vector2f() && mContainingWorld)
+		mContainingWorld->wake(*this);
 }
 
 /**
@@ -137,29 +176,61 @@ void
 Sprite::setDirection(const Vector2f& direction) {
 	if (direction != Vector2f())
 		mShape.setRotation(thor::polarAngle(direction) + 90);
+	mDirection = thor::rotatedVector(Vector2f(0, - 1), mShape.getRotation());
+	updateExtent();
+}
+
+/**
+ * Sets which categories this Sprite collides with.
+ */
+void
+Sprite::setMask(unsigned short mask) {
+	if (mBodies)
+		mBodies->setMask(*this, mask);
+	else
+		mMask = mask;
 }
 
 /**
  * Sets the position of thr Sprite.
+ *
+ * World only notices position changes made in World::step, so this must not
+ * be called by subclasses while the sprite is inserted into a World.
  */
 void
 Sprite::setPosition(const Vector2f& position) {
-	mShape.setPosition(position);
+	if (mBodies)
+		mBodies->setPosition(*this, position);
+	else
+		mPosition = position;
 }
 
+/**
+ * Recalculates mExtent from size and direction.
+ */
+void
+Sprite::updateExtent() {
+	// mDirection is the rotated y axis, so x is the sine and y the cosine.
+	float cos = std::abs(mDirection.y);
+	float sin = std::abs(mDirection.x);
+	mExtent = Vector2f(cos * mHalfSize.x + sin * mHalfSize.y,
+			sin * mHalfSize.x + cos * mHalfSize.y);
+}
 
 /**
  * Sets a new texture. The old one is discarded through smart pointers if
  * it isn't used any more.
  */
 void
-Sprite::setTexture(const std::string& texture) {
+Sprite::setTexture(Loader::ResourceId texture) {
+	mTextureId = texture;
 	try {
-		mTexture = Loader::i().fromFile<sf::Texture>(texture);
+		mTexture = Loader::i().fromId<sf::Texture>(texture);
 		mShape.setTexture(&*mTexture, false);
 	}
 	catch (thor::ResourceLoadingException&) {
-		LOG_W("Failed to load texture " << texture << ", coloring red.");
+		LOG_W("Failed to load texture " << Loader::i().getPath<sf::Texture>(texture)
+				<< ", coloring red.");
 		mShape.setFillColor(sf::Color(255, 0, 0));
 	}
 }
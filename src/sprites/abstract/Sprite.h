@@ -12,12 +12,31 @@
 
 #include <SFML/Graphics.hpp>
 
+#include "../../util/Config.h"
+#include "../../util/Loader.h"
 #include "../../util/Vector.h"
 
+class BodyStore;
+class World;
+
+/**
+ * Size and texture of a sprite type, read from its YAML file.
+ */
+struct SpriteConfig {
+	Vector2f size;
+	Loader::ResourceId texture;
+
+	static const ConfigFields<SpriteConfig>& getFields();
+};
+
 /**
  * An sprite that is rendered in the world.
+ *
+ * Position, speed and collision mask are stored in the BodyStore of the
+ * World the sprite is inserted into, the sprite only keeps them while it is
+ * not inserted.
  */
-class Sprite : public sf::Drawable {
+class Sprite : public sf::Drawable, public std::enable_shared_from_this<Sprite> {
 public:
 	/**
 	 * Categories of objects for filtering.
@@ -43,9 +62,10 @@ public:
 public:
 	explicit Sprite(const Vector2f& position, Category category,
 			unsigned short mask, const Vector2f& size,
-			const std::string& texture,	const Vector2f& direction);
+			Loader::ResourceId texture, const Vector2f& direction);
 	virtual ~Sprite() = default;
 
+	unsigned int getId() const;
 	Vector2f getPosition() const;
 	Vector2f getSpeed() const;
 	Vector2f getDirectionVector() const;
@@ -53,6 +73,7 @@ public:
 	bool getDelete() const;
 	Category getCategory() const;
 	Vector2f getSize() const;
+	Vector2f getHalfSize() const;
 	virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
 	bool collisionEnabled(Category category) const;
 	bool isInside(const sf::FloatRect& rect) const;
@@ -66,18 +87,47 @@ protected:
 	void setSpeed(Vector2f direction, float speed);
 	void setDirection(const Vector2f& direction);
 	void setPosition(const Vector2f& position);
-	void setTexture(const std::string& texture);
+	void setTexture(Loader::ResourceId texture);
+	void setMask(unsigned short mask);
+
+private:
+	void updateExtent();
 
 private:
+	friend class BodyStore;
 	friend class CollisionModel;
 	friend class World;
 
+	/// Unique for each sprite created during the program run, starting at 1.
+	const unsigned int mId;
+	static unsigned int mNextId;
+	/// Size, rotation and texture, at position zero.
 	sf::RectangleShape mShape;
 	std::shared_ptr<sf::Texture> mTexture;
-	Vector2f mSpeed;
+	/// Id of mTexture, used to find it in World's texture atlas.
+	Loader::ResourceId mTextureId;
+	/// Half of the size, not considering rotation.
+	Vector2f mHalfSize;
+	/// Unit vector pointing in the direction of mShape's rotation.
+	Vector2f mDirection;
+	/// Half of the size of the axis aligned bounding box, including
+	/// rotation.
+	Vector2f mExtent;
 	Category mCategory;
+	/// Only used while not in mBodies.
+	Vector2f mPosition;
+	Vector2f mSpeed;
 	unsigned short mMask;
+	/// Store that holds position, speed and mask while inserted into a
+	/// World, and the index of the slot in it.
+	BodyStore* mBodies = nullptr;
+	size_t mSlot = 0;
 	bool mDelete = false;
+	/// World this sprite was inserted into, to wake it up when it starts
+	/// moving or is marked for deletion.
+	World* mContainingWorld = nullptr;
+	/// True while the sprite is in World's list of active sprites.
+	bool mActive = false;
 };
 
 #endif /* DG_SPRITE_H_ */
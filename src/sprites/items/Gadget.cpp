@@ -16,7 +16,7 @@
  * @param cooldown Time in milliseconds after which the gadget can be used again.
  */
 Gadget::Gadget(std::string name, int cooldown) :
-		Item(sf::Vector2f(32, 32), "item.png"),
+		Item(sf::Vector2f(32, 32), Loader::i().getId<sf::Texture>("item.png")),
 		mName(name),
 		mCooldown(sf::milliseconds(cooldown)) {
 }
@@ -14,7 +14,8 @@ HealthOrb::HealthOrb() :
 }
 
 HealthOrb::HealthOrb(const Yaml& config) :
-		Item(config.get("size", Vector2i()), config.get("texture", std::string())),
+		Item(loadConfig<SpriteConfig>(CONFIG_NAME)->size,
+				loadConfig<SpriteConfig>(CONFIG_NAME)->texture),
 		mName(config.get("name", std::string())),
 		mAmountHealed(config.get("amount_healed", 0)) {
 }
@@ -9,7 +9,7 @@
 
 #include "../../World.h"
 
-Item::Item(const Vector2f& size, const std::string& texture) :
+Item::Item(const Vector2f& size, Loader::ResourceId texture) :
 		Sprite(Vector2f(), CATEGORY_NONSOLID, MASK_NONE, size, texture,
 				Vector2f()) {
 }
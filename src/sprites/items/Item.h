@@ -14,7 +14,7 @@ class World;
 
 class Item : public Sprite {
 public:
-	Item(const Vector2f& size, const std::string& texture);
+	Item(const Vector2f& size, Loader::ResourceId texture);
 	virtual ~Item() {};
 
 	virtual std::string getName() const = 0;
@@ -9,7 +9,6 @@
 
 #include <Thor/Vectors.hpp>
 
-#include "../effects/Bullet.h"
 #include "../../World.h"
 
 const std::string RingOfFire::CONFIG_NAME = "ring_of_fire.yaml";
@@ -26,7 +25,7 @@ RingOfFire::RingOfFire(World& world, const Yaml& config) :
 	mDelay(sf::milliseconds(config.get("delay", 0))),
 	mCurrentWave(mWavesPerUse + 1),
 	mWorld(world),
-	mBullet(config.get("bullet", std::string())) {
+	mBullet(loadConfig<BulletConfig>(config.get("bullet", std::string()))) {
 
 }
 
@@ -43,9 +42,8 @@ RingOfFire::onThink(int elapsed) {
 			Vector2f direction(thor::rotatedVector(mCharacter->getDirectionVector(), (float) angle) *
 					mCharacter->getRadius());
 
-			std::shared_ptr<Sprite> projectile(new Bullet(mCharacter->getPosition() + direction,
-					*mCharacter, direction, mBullet, 200, 20, 0));
-			mWorld.insert(projectile);
+			mWorld.insertBullet(mCharacter->getPosition() + direction, *mCharacter,
+					thor::rotatedVector(direction, -90.0f), *mBullet, 200, 20, 0);
 		}
 
 		mTimer.restart(mDelay);
@@ -11,6 +11,7 @@
 #include "Gadget.h"
 #include "../abstract/Character.h"
 #include "../../util/Yaml.h"
+#include "../../BulletSystem.h"
 
 /**
  * Gadget that fires bullets in all directions for multiple waves.
@@ -39,7 +40,7 @@ private:
 	Character* mCharacter;
 	thor::Timer mTimer;
 	World& mWorld;
-	const Yaml mBullet;
+	const std::shared_ptr<const BulletConfig> mBullet;
 };
 
 #endif /* DG_RINGOFFIRE_H_ */
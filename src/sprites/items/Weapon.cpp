@@ -10,33 +10,68 @@
 #include <Thor/Vectors.hpp>
 
 #include "../../World.h"
-#include "../effects/Bullet.h"
-#include "../../util/Yaml.h"
-
-Weapon::Weapon(World& world, Character& holder, const Yaml& config, WeaponType type) :
-		Item(Vector2f(32, 32), "item.png"),
+#include "../../util/ConfigWatcher.h"
+#include "../../util/Trace.h"
+
+const ConfigFields<WeaponConfig>&
+WeaponConfig::getFields() {
+	static const ConfigFields<WeaponConfig> fields = ConfigFields<WeaponConfig>()
+			.add("name", &WeaponConfig::name)
+			.add("bullet", &WeaponConfig::bullet)
+			.add("damage", &WeaponConfig::damage)
+			.add("projectile_speed", &WeaponConfig::projectileSpeed)
+			.add("fire_interval", &WeaponConfig::fireInterval)
+			.add("reload_time", &WeaponConfig::reloadTime)
+			.add("automatic", &WeaponConfig::automatic)
+			.add("magazine_size", &WeaponConfig::magazineSize)
+			.add("max_total_ammo", &WeaponConfig::maxTotalAmmo)
+			.add("pellets", &WeaponConfig::pellets)
+			.add("pellet_spread", &WeaponConfig::pelletSpread)
+			.add("reload_single", &WeaponConfig::reloadSingle)
+			.add("spread", &WeaponConfig::spread)
+			.add("spread_moving", &WeaponConfig::spreadMoving)
+			.add("max_range", &WeaponConfig::maxRange)
+			.add("requires_no_ammo", &WeaponConfig::requiresNoAmmo);
+	return fields;
+}
+
+Weapon::Weapon(World& world, Character& holder, WeaponType type) :
+		Item(Vector2f(32, 32), Loader::i().getId<sf::Texture>("item.png")),
 		mWorld(world),
 		mHolder(&holder),
-		mName(config.get("name", std::string())),
-		mProjectile(config.get("bullet", std::string("bullet.yaml"))),
-		mDamage(config.get("damage", 0)),
-		mProjectileSpeed(config.get("projectile_speed", 0.0f)),
-		mFireInterval(config.get("fire_interval", 0)),
-		mReloadTime(config.get("reload_time", 0)),
+		mConfig(loadConfig<WeaponConfig>(getConfig(type))),
+		mProjectile(loadConfig<BulletConfig>(mConfig->bullet)),
 		mFiring(false),
-		mAutomatic(config.get("automatic", false)),
-		mMagazineSize(config.get("magazine_size", 0)),
-		mMagazineAmmo(mMagazineSize),
-		mMaxTotalAmmo(config.get("max_total_ammo", 0)),
-		mTotalAmmo(mMaxTotalAmmo),
-		mPellets(config.get("pellets", 0)),
-		mPelletSpread(config.get("pellet_spread", 0.0f)),
-		mReloadSingle(config.get("reload_single", false)),
-		mSpread(config.get("spread", 0.0f)),
-		mSpreadMoving(config.get("spread_moving", 0.0f)),
-		mMaxRange(config.get("max_range", 0.0f)),
-		mRequiresAmmo(!config.get("requires_no_ammo", false)),
-		mType(type) {
+		mMagazineAmmo(mConfig->magazineSize),
+		mTotalAmmo(mConfig->maxTotalAmmo),
+		mType(type) {
+	// Ammo is kept, new magazine sizes apply from the next reload.
+	mConfigSubscription = ConfigWatcher::i().subscribe(getConfig(type), [this]() {
+		std::string bullet = mConfig->bullet;
+		mConfig = loadConfig<WeaponConfig>(getConfig(mType));
+		mProjectile = loadConfig<BulletConfig>(mConfig->bullet);
+		if (mConfig->bullet != bullet) {
+			ConfigWatcher::i().unsubscribe(mProjectileSubscription);
+			subscribeProjectile();
+		}
+	});
+	subscribeProjectile();
+}
+
+Weapon::~Weapon() {
+	ConfigWatcher::i().unsubscribe(mConfigSubscription);
+	ConfigWatcher::i().unsubscribe(mProjectileSubscription);
+}
+
+/**
+ * Reloads mProjectile whenever the bullet config file of the weapon
+ * changes.
+ */
+void
+Weapon::subscribeProjectile() {
+	mProjectileSubscription = ConfigWatcher::i().subscribe(mConfig->bullet, [this]() {
+		mProjectile = loadConfig<BulletConfig>(mConfig->bullet);
+	});
 }
 
 /**
@@ -45,23 +80,33 @@ Weapon::Weapon(World& world, Character& holder, const Yaml& config, WeaponType t
  */
 std::shared_ptr<Weapon>
 Weapon::getWeapon(World& world, Character& holder, WeaponType type) {
+	if (getConfig(type).empty())
+		return std::shared_ptr<Weapon>();
+	return std::shared_ptr<Weapon>(new Weapon(world, holder, type));
+}
+
+/**
+ * Returns the YAML config file name for the weapon type.
+ */
+std::string
+Weapon::getConfig(WeaponType type) {
 	switch (type) {
 	case WeaponType::KNIFE:
-		return std::shared_ptr<Weapon>(new Weapon(world, holder, Yaml("knife.yaml"), type));
+		return "knife.yaml";
 	case WeaponType::PISTOL:
-		return std::shared_ptr<Weapon>(new Weapon(world, holder, Yaml("pistol.yaml"), type));
+		return "pistol.yaml";
 	case WeaponType::ASSAULT_RIFLE:
-		return std::shared_ptr<Weapon>(new Weapon(world, holder, Yaml("assault_rifle.yaml"), type));
+		return "assault_rifle.yaml";
 	case WeaponType::SHOTGUN:
-		return std::shared_ptr<Weapon>(new Weapon(world, holder, Yaml("shotgun.yaml"), type));
+		return "shotgun.yaml";
 	case WeaponType::AUTO_SHOTGUN:
-		return std::shared_ptr<Weapon>(new Weapon(world, holder, Yaml("auto_shotgun.yaml"), type));
+		return "auto_shotgun.yaml";
 	case WeaponType::RIFLE:
-		return std::shared_ptr<Weapon>(new Weapon(world, holder, Yaml("rifle.yaml"), type));
+		return "rifle.yaml";
 	case WeaponType::HMG:
-		return std::shared_ptr<Weapon>(new Weapon(world, holder, Yaml("hmg.yaml"), type));
+		return "hmg.yaml";
 	default:
-		return std::shared_ptr<Weapon>();
+		return "";
 	}
 }
 
@@ -92,9 +137,9 @@ Weapon::onThink(int elapsed) {
 		return;
 
 	if (mIsReloading) {
-		if (!mReloadSingle) {
-			mMagazineAmmo = (mTotalAmmo >= mMagazineSize)
-					? mMagazineSize
+		if (!mConfig->reloadSingle) {
+			mMagazineAmmo = (mTotalAmmo >= mConfig->magazineSize)
+					? mConfig->magazineSize
 					: mTotalAmmo;
 			mTotalAmmo -= mMagazineAmmo;
 			mIsReloading = false;
@@ -102,7 +147,7 @@ Weapon::onThink(int elapsed) {
 		else if (mTotalAmmo > 0) {
 			mMagazineAmmo++;
 			mTotalAmmo--;
-			if (mMagazineAmmo == mMagazineSize)
+			if (mMagazineAmmo == mConfig->magazineSize)
 				mIsReloading = false;
 			else
 				reload();
@@ -111,13 +156,13 @@ Weapon::onThink(int elapsed) {
 			mIsReloading = false;
 	}
 
-	if (mFiring && (!mRequiresAmmo || mMagazineAmmo != 0)) {
+	if (mFiring && (mConfig->requiresNoAmmo || mMagazineAmmo != 0)) {
 		fire();
-		if (!mAutomatic)
+		if (!mConfig->automatic)
 			mFiring = false;
 	}
 
-	if (mRequiresAmmo && mMagazineAmmo == 0 && mTotalAmmo != 0)
+	if (!mConfig->requiresNoAmmo && mMagazineAmmo == 0 && mTotalAmmo != 0)
 		reload();
 }
 
@@ -126,17 +171,21 @@ Weapon::onThink(int elapsed) {
  */
 void
 Weapon::fire() {
-	mTimer.restart(sf::milliseconds(mFireInterval));
-	if (mRequiresAmmo)
+	mTimer.restart(sf::milliseconds(mConfig->fireInterval));
+	if (!mConfig->requiresNoAmmo)
 		mMagazineAmmo--;
 
 
-	if (mPellets == 0)
+	if (mConfig->pellets == 0)
 		insertProjectile(0.0f);
 	else
-		for (int i = - mPellets / 2; i < mPellets / 2; i++) {
-			insertProjectile(i * mPelletSpread);
-		}
+		for (int i = - mConfig->pellets / 2; i < mConfig->pellets / 2; i++) {
+			insertProjectile(i * mConfig->pelletSpread);
+		}
+	if (Trace::isEnabled())
+		Trace::record(Trace::FIRE, mHolder->getId(),
+				(mConfig->pellets == 0) ? 1 : mConfig->pellets / 2 * 2,
+				mHolder->getPosition().x, mHolder->getPosition().y);
 }
 
 int
@@ -151,22 +200,22 @@ Weapon::getTotalAmmo() const {
 
 std::string
 Weapon::getName() const {
-	return mName;
+	return mConfig->name;
 }
 
 void
 Weapon::reload() {
-	if (mMagazineAmmo == mMagazineSize)
+	if (mMagazineAmmo == mConfig->magazineSize)
 		return;
 	mIsReloading = true;
-	mTimer.restart(sf::milliseconds(mReloadTime));
+	mTimer.restart(sf::milliseconds(mConfig->reloadTime));
 }
 
 void
 Weapon::cancelReload() {
 	mIsReloading = false;
 	// To make sure time isn't skipped.
-	mTimer.restart(sf::milliseconds(mFireInterval));
+	mTimer.restart(sf::milliseconds(mConfig->fireInterval));
 }
 
 void
@@ -184,17 +233,16 @@ Weapon::insertProjectile(float angle) {
 	Vector2f offset(mHolder->getDirectionVector() * mHolder->getRadius());
 
 	float spread = (mHolder->getSpeed() == Vector2f())
-			? mSpread
-			: mSpreadMoving;
+			? mConfig->spread
+			: mConfig->spreadMoving;
 	std::uniform_real_distribution<float> distribution(- spread, spread);
-	angle += distribution(mGenerator) + 90.0f;
+	angle += distribution(mGenerator);
 
 	Vector2f direction(thor::rotatedVector(mHolder->getDirectionVector(), angle));
 
-	std::shared_ptr<Sprite> projectile(new Bullet(mHolder->getPosition() + offset,
-			*mHolder, direction, mProjectile, mProjectileSpeed,
-			mDamage, mMaxRange));
-	mWorld.insert(projectile);
+	mWorld.insertBullet(mHolder->getPosition() + offset, *mHolder, direction,
+			*mProjectile, mConfig->projectileSpeed, mConfig->damage,
+			mConfig->maxRange);
 }
 
 Weapon::WeaponType
@@ -16,12 +16,37 @@
 #include <Thor/Time.hpp>
 
 #include "Item.h"
-#include "../../util/Yaml.h"
+#include "../../BulletSystem.h"
+#include "../../util/Config.h"
 
 class Character;
 class World;
 class Particle;
-class Yaml;
+
+/**
+ * Values of a weapon type, read from its YAML file.
+ */
+struct WeaponConfig {
+	std::string name;
+	/// File name of the BulletConfig for projectiles.
+	std::string bullet = "bullet.yaml";
+	int damage = 0;
+	float projectileSpeed = 0;
+	int fireInterval = 0;
+	int reloadTime = 0;
+	bool automatic = false;
+	int magazineSize = 0;
+	int maxTotalAmmo = 0;
+	int pellets = 0;
+	float pelletSpread = 0;
+	bool reloadSingle = false;
+	float spread = 0;
+	float spreadMoving = 0;
+	float maxRange = 0;
+	bool requiresNoAmmo = false;
+
+	static const ConfigFields<WeaponConfig>& getFields();
+};
 
 class Weapon : public Item {
 public:
@@ -41,8 +66,10 @@ public:
 	};
 
 public:
-	explicit Weapon(World& world, Character& holder, const Yaml& config, WeaponType type);
+	explicit Weapon(World& world, Character& holder, WeaponType type);
+	~Weapon();
 	static std::shared_ptr<Weapon> getWeapon(World& world, Character& holder, WeaponType type);
+	static std::string getConfig(WeaponType type);
 
 	void pullTrigger();
 	void releaseTrigger();
@@ -58,6 +85,7 @@ public:
 private:
 	void fire();
 	void insertProjectile(float angle);
+	void subscribeProjectile();
 
 private:
 	World& mWorld;
@@ -65,26 +93,18 @@ private:
 	Character* mHolder;
 
 	thor::Timer mTimer;
-	const std::string mName;
-	const Yaml mProjectile;
-	const int mDamage;
-	const float mProjectileSpeed;
-	const int mFireInterval;
-	const int mReloadTime;
+	/// Shared between all weapons of the same type, replaced when the
+	/// config file is reloaded.
+	std::shared_ptr<const WeaponConfig> mConfig;
+	std::shared_ptr<const BulletConfig> mProjectile;
+	/// Id of the ConfigWatcher subscription for mConfig.
+	int mConfigSubscription;
+	/// Id of the ConfigWatcher subscription for mProjectile.
+	int mProjectileSubscription;
 	bool mFiring;
-	const bool mAutomatic;
-	const int mMagazineSize;
 	int mMagazineAmmo;
-	const int mMaxTotalAmmo;
 	int mTotalAmmo;
 	bool mIsReloading = false;
-	const int mPellets;
-	const float mPelletSpread;
-	const bool mReloadSingle;
-	const float mSpread;
-	const float mSpreadMoving;
-	const float mMaxRange;
-	const float mRequiresAmmo;
 	std::default_random_engine mGenerator;
 	WeaponType mType;
 
@@ -0,0 +1,42 @@
+/*
+ * Config.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "Config.h"
+
+namespace {
+
+/**
+ * One function per instantiated ConfigCache, which rereads a file if the
+ * cache contains it.
+ */
+std::vector<std::function<void(const std::string&)> >&
+getReloaders() {
+	static std::vector<std::function<void(const std::string&)> > reloaders;
+	return reloaders;
+}
+
+}
+
+/**
+ * Called by each ConfigCache when it is created.
+ */
+void
+registerConfigReloader(std::function<void(const std::string&)> reloader) {
+	getReloaders().push_back(reloader);
+}
+
+/**
+ * Rereads filename into every config type that was loaded from it. Objects
+ * returned by loadConfig before keep their old values, later calls return
+ * the new ones.
+ *
+ * The file must already have been reloaded into Yaml's cache.
+ */
+void
+reloadConfigs(const std::string& filename) {
+	for (const auto& reloader : getReloaders())
+		reloader(filename);
+}
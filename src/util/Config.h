@@ -0,0 +1,141 @@
+/*
+ * Config.h
+ *
+ *  Created on: 19.10.2026
+ */
+
+#ifndef DG_CONFIG_H_
+#define DG_CONFIG_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Loader.h"
+#include "Yaml.h"
+
+/**
+ * Table of the fields of config struct C, mapping YAML keys to members.
+ *
+ * Every config struct provides a static getFields that lists its fields
+ * once. The values the members are initialized with are used as defaults
+ * for keys that are missing in the file.
+ *
+ * @code
+ * struct MyConfig {
+ * 	int health = 100;
+ * 	static const ConfigFields<MyConfig>& getFields();
+ * };
+ *
+ * const ConfigFields<MyConfig>&
+ * MyConfig::getFields() {
+ * 	static const ConfigFields<MyConfig> fields = ConfigFields<MyConfig>()
+ * 			.add("health", &MyConfig::health);
+ * 	return fields;
+ * }
+ * @endcode
+ */
+template <class C>
+class ConfigFields {
+public:
+	/**
+	 * Reads key into member, leaving the member unchanged if key is missing.
+	 */
+	template <typename T>
+	ConfigFields&
+	add(const std::string& key, T C::* member) {
+		mReaders.push_back([key, member](const Yaml& yaml, C& config) {
+			config.*member = yaml.get(key, config.*member);
+		});
+		return *this;
+	}
+
+	/**
+	 * Reads the texture file name in key and stores its id, so that it is
+	 * only looked up once per config instead of for every sprite. A missing
+	 * key gives the id of an empty file name, which fails to load.
+	 */
+	ConfigFields&
+	addTexture(const std::string& key, Loader::ResourceId C::* member) {
+		mReaders.push_back([key, member](const Yaml& yaml, C& config) {
+			config.*member = Loader::i().getId<sf::Texture>(
+					yaml.get(key, std::string()));
+		});
+		return *this;
+	}
+
+	/**
+	 * Sets all fields of config from yaml.
+	 */
+	void
+	read(const Yaml& yaml, C& config) const {
+		for (const auto& reader : mReaders)
+			reader(yaml, config);
+	}
+
+private:
+	std::vector<std::function<void(const Yaml&, C&)> > mReaders;
+};
+
+void registerConfigReloader(std::function<void(const std::string&)> reloader);
+void reloadConfigs(const std::string& filename);
+
+/**
+ * Configs of type C by file name, used through loadConfig.
+ */
+template <class C>
+class ConfigCache {
+public:
+	/**
+	 * Returns the config stored in filename, reading it on first use.
+	 */
+	static std::shared_ptr<const C>
+	get(const std::string& filename) {
+		std::shared_ptr<const C>& cached = instance().mConfigs[filename];
+		if (!cached)
+			cached = read(filename);
+		return cached;
+	}
+
+private:
+	ConfigCache() {
+		registerConfigReloader([this](const std::string& filename) {
+			auto config = mConfigs.find(filename);
+			if (config != mConfigs.end())
+				config->second = read(filename);
+		});
+	}
+
+	static ConfigCache&
+	instance() {
+		static ConfigCache cache;
+		return cache;
+	}
+
+	static std::shared_ptr<const C>
+	read(const std::string& filename) {
+		std::shared_ptr<C> config = std::make_shared<C>();
+		C::getFields().read(Yaml(filename), *config);
+		return config;
+	}
+
+private:
+	std::unordered_map<std::string, std::shared_ptr<const C> > mConfigs;
+};
+
+/**
+ * Returns the config of type C stored in filename. Each file is only read
+ * once, later calls return the same object until the file is reloaded via
+ * reloadConfigs.
+ *
+ * @param filename Path relative to the folder set in Yaml::setFolder.
+ */
+template <class C>
+std::shared_ptr<const C>
+loadConfig(const std::string& filename) {
+	return ConfigCache<C>::get(filename);
+}
+
+#endif /* DG_CONFIG_H_ */
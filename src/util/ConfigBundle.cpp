@@ -0,0 +1,222 @@
+/*
+ * ConfigBundle.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "ConfigBundle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "Log.h"
+
+const char ConfigBundle::MAGIC[4] = {'D', 'G', 'C', 'B'};
+
+/**
+ * Reads a bundle created by write. Returns false and leaves the bundle
+ * empty if the file does not exist, has an unknown version or is corrupt.
+ */
+bool
+ConfigBundle::load(const std::string& path) {
+	mData.clear();
+	mHeader = nullptr;
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return false;
+	std::vector<char> data((std::istreambuf_iterator<char>(file)),
+			std::istreambuf_iterator<char>());
+
+	if (data.size() < sizeof(Header))
+		return false;
+	const Header* header = reinterpret_cast<const Header*>(data.data());
+	if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 ||
+			header->version != VERSION) {
+		LOG_W("Ignoring config bundle " << path << " with unknown version");
+		return false;
+	}
+	size_t size = sizeof(Header) + header->fileCount * sizeof(FileRecord) +
+			header->entryCount * sizeof(EntryRecord) +
+			header->valueCount * sizeof(String) + header->stringsSize;
+	if (data.size() != size) {
+		LOG_W("Ignoring truncated config bundle " << path);
+		return false;
+	}
+
+	mData.swap(data);
+	mHeader = reinterpret_cast<const Header*>(mData.data());
+	mFiles = reinterpret_cast<const FileRecord*>(mHeader + 1);
+	mEntries = reinterpret_cast<const EntryRecord*>(mFiles + mHeader->fileCount);
+	mValues = reinterpret_cast<const String*>(mEntries + mHeader->entryCount);
+	mStrings = reinterpret_cast<const char*>(mValues + mHeader->valueCount);
+	if (!isValid()) {
+		LOG_W("Ignoring corrupt config bundle " << path);
+		mData.clear();
+		mHeader = nullptr;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Checks that all offsets and ranges in the loaded data point into their
+ * sections, so that getNode can use them unchecked.
+ */
+bool
+ConfigBundle::isValid() const {
+	auto isValidString = [this](const String& string) {
+		return string.offset <= mHeader->stringsSize &&
+				string.length <= mHeader->stringsSize - string.offset;
+	};
+	for (uint32_t f = 0; f < mHeader->fileCount; f++) {
+		const FileRecord& file = mFiles[f];
+		if (!isValidString(file.name) ||
+				file.firstEntry > mHeader->entryCount ||
+				file.entryCount > mHeader->entryCount - file.firstEntry)
+			return false;
+	}
+	for (uint32_t e = 0; e < mHeader->entryCount; e++) {
+		const EntryRecord& entry = mEntries[e];
+		if (!isValidString(entry.key) ||
+				entry.firstValue > mHeader->valueCount ||
+				entry.valueCount > mHeader->valueCount - entry.firstValue ||
+				(!entry.sequence && entry.valueCount != 1))
+			return false;
+	}
+	for (uint32_t v = 0; v < mHeader->valueCount; v++) {
+		if (!isValidString(mValues[v]))
+			return false;
+	}
+	return true;
+}
+
+bool
+ConfigBundle::isLoaded() const {
+	return mHeader != nullptr;
+}
+
+/**
+ * Builds the node for filename from the bundle.
+ *
+ * @return False if no bundle is loaded or it does not contain filename.
+ */
+bool
+ConfigBundle::getNode(const std::string& filename, YAML::Node& node) const {
+	if (!isLoaded())
+		return false;
+	const FileRecord* end = mFiles + mHeader->fileCount;
+	const FileRecord* file = std::lower_bound(mFiles, end, filename,
+			[this](const FileRecord& record, const std::string& name) {
+				return toString(record.name) < name;
+			});
+	if (file == end || toString(file->name) != filename)
+		return false;
+
+	node = YAML::Node(YAML::NodeType::Map);
+	for (uint32_t e = 0; e < file->entryCount; e++) {
+		const EntryRecord& entry = mEntries[file->firstEntry + e];
+		if (entry.sequence) {
+			YAML::Node sequence(YAML::NodeType::Sequence);
+			for (uint32_t v = 0; v < entry.valueCount; v++)
+				sequence.push_back(toString(mValues[entry.firstValue + v]));
+			node[toString(entry.key)] = sequence;
+		}
+		else
+			node[toString(entry.key)] = toString(mValues[entry.firstValue]);
+	}
+	return true;
+}
+
+std::string
+ConfigBundle::toString(const String& string) const {
+	return std::string(mStrings + string.offset, string.length);
+}
+
+/**
+ * Parses YAML files and writes them into a bundle at path.
+ *
+ * @param folder Prepended to each file name when reading.
+ * @param filenames Names by which the files are found in the bundle,
+ * 					relative to folder.
+ * @return False if a file could not be read or has an unsupported
+ * 		   structure, nothing is written in that case.
+ */
+bool
+ConfigBundle::write(const std::string& path, const std::string& folder,
+		const std::vector<std::string>& filenames) {
+	std::vector<FileRecord> files;
+	std::vector<EntryRecord> entries;
+	std::vector<String> values;
+	std::string strings;
+	auto addString = [&strings](const std::string& value) {
+		String string = {(uint32_t) strings.size(), (uint32_t) value.size()};
+		strings += value;
+		return string;
+	};
+
+	std::vector<std::string> sorted(filenames);
+	std::sort(sorted.begin(), sorted.end());
+	for (const auto& filename : sorted) {
+		YAML::Node root;
+		try {
+			root = YAML::LoadFile(folder + filename);
+		}
+		catch (const YAML::Exception& e) {
+			LOG_E("Failed to parse " << folder << filename << ": " << e.what());
+			return false;
+		}
+		if (!root.IsMap() && !root.IsNull()) {
+			LOG_E(folder << filename << " is not a map");
+			return false;
+		}
+		FileRecord file = {addString(filename), (uint32_t) entries.size(), 0};
+		for (const auto& pair : root) {
+			EntryRecord entry = {addString(pair.first.as<std::string>()),
+					(uint32_t) values.size(), 0, pair.second.IsSequence()};
+			if (pair.second.IsScalar())
+				values.push_back(addString(pair.second.Scalar()));
+			else if (pair.second.IsSequence()) {
+				for (const auto& value : pair.second) {
+					if (!value.IsScalar()) {
+						LOG_E(folder << filename << ": nested values are not supported");
+						return false;
+					}
+					values.push_back(addString(value.Scalar()));
+				}
+			}
+			else {
+				LOG_E(folder << filename << ": nested values are not supported");
+				return false;
+			}
+			entry.valueCount = values.size() - entry.firstValue;
+			entries.push_back(entry);
+		}
+		file.entryCount = entries.size() - file.firstEntry;
+		files.push_back(file);
+	}
+
+	Header header;
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.fileCount = files.size();
+	header.entryCount = entries.size();
+	header.valueCount = values.size();
+	header.stringsSize = strings.size();
+
+	std::ofstream out(path, std::ios::binary);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(files.data()),
+			files.size() * sizeof(FileRecord));
+	out.write(reinterpret_cast<const char*>(entries.data()),
+			entries.size() * sizeof(EntryRecord));
+	out.write(reinterpret_cast<const char*>(values.data()),
+			values.size() * sizeof(String));
+	out.write(strings.data(), strings.size());
+	if (!out) {
+		LOG_E("Failed to write config bundle " << path);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,93 @@
+/*
+ * ConfigBundle.h
+ *
+ *  Created on: 19.10.2026
+ */
+
+#ifndef DG_CONFIGBUNDLE_H_
+#define DG_CONFIGBUNDLE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <yaml-cpp/yaml.h>
+
+/**
+ * All YAML config files packed into a single binary file, so they can be
+ * read at startup without running the YAML parser.
+ *
+ * Only files whose root is a map of scalars and sequences of scalars can be
+ * packed, which covers all files in res/yaml. The layout is flat and uses
+ * offsets only, in native byte order:
+ *
+ * @code
+ * Header
+ * FileRecord[fileCount]    sorted by name
+ * EntryRecord[entryCount]  keys of all files, grouped by file
+ * String[valueCount]       values of all entries, grouped by entry
+ * char[stringsSize]        names, keys and values, not null terminated
+ * @endcode
+ */
+class ConfigBundle {
+public:
+	/// Increase whenever the layout changes, bundles with another version
+	/// are ignored.
+	static const uint32_t VERSION = 1;
+
+public:
+	bool load(const std::string& path);
+	bool isLoaded() const;
+	bool getNode(const std::string& filename, YAML::Node& node) const;
+
+	static bool write(const std::string& path, const std::string& folder,
+			const std::vector<std::string>& filenames);
+
+private:
+	struct Header {
+		char magic[4];
+		uint32_t version;
+		uint32_t fileCount;
+		uint32_t entryCount;
+		uint32_t valueCount;
+		uint32_t stringsSize;
+	};
+
+	/**
+	 * Position of a string in the string section.
+	 */
+	struct String {
+		uint32_t offset;
+		uint32_t length;
+	};
+
+	struct FileRecord {
+		String name;
+		uint32_t firstEntry;
+		uint32_t entryCount;
+	};
+
+	struct EntryRecord {
+		String key;
+		uint32_t firstValue;
+		uint32_t valueCount;
+		/// 1 if the values form a sequence, 0 for a single scalar.
+		uint32_t sequence;
+	};
+
+	static const char MAGIC[4];
+
+private:
+	bool isValid() const;
+	std::string toString(const String& string) const;
+
+private:
+	std::vector<char> mData;
+	const Header* mHeader = nullptr;
+	const FileRecord* mFiles = nullptr;
+	const EntryRecord* mEntries = nullptr;
+	const String* mValues = nullptr;
+	const char* mStrings = nullptr;
+};
+
+#endif /* DG_CONFIGBUNDLE_H_ */
@@ -0,0 +1,153 @@
+/*
+ * ConfigWatcher.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "ConfigWatcher.h"
+
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "Config.h"
+#include "Log.h"
+#include "Yaml.h"
+
+ConfigWatcher::~ConfigWatcher() {
+	stop();
+}
+
+/**
+ * Starts watching folder for changed files. Does nothing if already
+ * started.
+ *
+ * @return False if files can't be watched on this system.
+ */
+bool
+ConfigWatcher::start(const std::string& folder) {
+	if (mRunning)
+		return true;
+#ifdef __linux__
+	mInotify = inotify_init1(IN_NONBLOCK);
+	if (mInotify == -1 ||
+			inotify_add_watch(mInotify, folder.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) == -1) {
+		LOG_W("Failed to watch config folder " << folder);
+		if (mInotify != -1)
+			close(mInotify);
+		mInotify = -1;
+		return false;
+	}
+	mFolder = folder;
+	mRunning = true;
+	mThread = std::thread(&ConfigWatcher::run, this);
+	return true;
+#else
+	LOG_W("Config reloading is not supported on this system");
+	return false;
+#endif
+}
+
+/**
+ * Stops the watcher thread. Changes that were already parsed are still
+ * applied by the next call to update.
+ */
+void
+ConfigWatcher::stop() {
+	if (!mRunning)
+		return;
+	mRunning = false;
+	mThread.join();
+#ifdef __linux__
+	close(mInotify);
+#endif
+	mInotify = -1;
+}
+
+/**
+ * Applies all changed files and notifies their subscribers. Must be called
+ * from the thread that runs the game.
+ */
+void
+ConfigWatcher::update() {
+	std::map<std::string, YAML::Node> changed;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		changed.swap(mChanged);
+	}
+	for (const auto& file : changed) {
+		Yaml::replace(file.first, file.second);
+		reloadConfigs(file.first);
+		LOG_I("Reloaded config " << file.first);
+
+		// Callbacks may unsubscribe others, so look each one up again.
+		std::vector<int> ids;
+		for (const auto& subscriber : mSubscribers)
+			if (subscriber.second.first == file.first)
+				ids.push_back(subscriber.first);
+		for (int id : ids) {
+			auto subscriber = mSubscribers.find(id);
+			if (subscriber != mSubscribers.end())
+				subscriber->second.second();
+		}
+	}
+}
+
+/**
+ * Calls callback from update whenever filename was changed, after the new
+ * values are available through Yaml and loadConfig.
+ *
+ * @return Id to pass to unsubscribe.
+ */
+int
+ConfigWatcher::subscribe(const std::string& filename,
+		std::function<void()> callback) {
+	mSubscribers[mNextId] = std::make_pair(filename, callback);
+	return mNextId++;
+}
+
+void
+ConfigWatcher::unsubscribe(int id) {
+	mSubscribers.erase(id);
+}
+
+/**
+ * Waits for file changes and parses changed files, until stop is called.
+ * Files that fail to parse (for example while still being written) are
+ * skipped, the next write triggers another attempt.
+ */
+void
+ConfigWatcher::run() {
+#ifdef __linux__
+	std::vector<char> buffer(4096);
+	while (mRunning) {
+		pollfd fd = {mInotify, POLLIN, 0};
+		if (poll(&fd, 1, POLL_INTERVAL) <= 0)
+			continue;
+		ssize_t length = read(mInotify, buffer.data(), buffer.size());
+		for (ssize_t i = 0; i < length; ) {
+			const inotify_event* event =
+					reinterpret_cast<const inotify_event*>(&buffer[i]);
+			i += sizeof(inotify_event) + event->len;
+			if (event->len == 0)
+				continue;
+			std::string filename(event->name);
+			if (filename.size() < 5 ||
+					filename.compare(filename.size() - 5, 5, ".yaml") != 0)
+				continue;
+			try {
+				YAML::Node node = YAML::LoadFile(mFolder + filename);
+				std::lock_guard<std::mutex> lock(mMutex);
+				mChanged[filename] = node;
+			}
+			catch (const YAML::Exception& e) {
+				LOG_W("Failed to reload config " << filename << ": " << e.what());
+			}
+		}
+	}
+#endif
+}
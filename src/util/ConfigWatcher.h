@@ -0,0 +1,77 @@
+/*
+ * ConfigWatcher.h
+ *
+ *  Created on: 19.10.2026
+ */
+
+#ifndef DG_CONFIGWATCHER_H_
+#define DG_CONFIGWATCHER_H_
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <SFML/System.hpp>
+
+#include <yaml-cpp/yaml.h>
+
+#include "Singleton.h"
+
+/**
+ * Reloads YAML config files while the game is running.
+ *
+ * A background thread waits for changes to files in the config folder
+ * (via inotify, so this only works on Linux) and parses them. update then
+ * puts the new documents into the caches of Yaml and loadConfig and calls
+ * everyone who subscribed to the file. Nothing is changed outside of
+ * update, so the game never sees a half reloaded config.
+ *
+ * @code
+ * ConfigWatcher::i().start("res/yaml/");
+ * int id = ConfigWatcher::i().subscribe("pistol.yaml", [this]() {
+ * 	mConfig = loadConfig<WeaponConfig>("pistol.yaml");
+ * });
+ * ConfigWatcher::i().update(); // once per frame
+ * ConfigWatcher::i().unsubscribe(id);
+ * @endcode
+ */
+class ConfigWatcher : public Singleton<ConfigWatcher> {
+public:
+	~ConfigWatcher();
+
+	bool start(const std::string& folder);
+	void stop();
+	void update();
+	int subscribe(const std::string& filename, std::function<void()> callback);
+	void unsubscribe(int id);
+
+private:
+	/**
+	 * For Singleton behaviour.
+	 */
+	ConfigWatcher() = default;
+	friend class Singleton<ConfigWatcher>;
+
+	void run();
+
+private:
+	/// Interval in milliseconds in which the thread checks if it should stop.
+	static const int POLL_INTERVAL = 200;
+
+	std::string mFolder;
+	int mInotify = -1;
+	std::thread mThread;
+	std::atomic<bool> mRunning{false};
+	/// Guards mChanged, which is written by the thread.
+	std::mutex mMutex;
+	/// Files that were parsed after changing, waiting for update.
+	std::map<std::string, YAML::Node> mChanged;
+	/// Callback and file name by subscription id.
+	std::map<int, std::pair<std::string, std::function<void()> > > mSubscribers;
+	int mNextId = 0;
+};
+
+#endif /* DG_CONFIGWATCHER_H_ */
@@ -0,0 +1,175 @@
+/*
+ * Loader.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "Loader.h"
+
+#include <algorithm>
+
+#include "Log.h"
+
+/**
+ * Stops the worker threads, files that were not decoded yet are dropped.
+ */
+Loader::~Loader() {
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mStopWorkers = true;
+	}
+	mJobAdded.notify_all();
+	for (auto& worker : mWorkers)
+		worker.join();
+}
+
+/**
+ * Starts decoding the texture with id on a worker thread. It is uploaded
+ * by the next call to update after decoding finished, and then kept until
+ * it is first requested through fromId.
+ *
+ * Does nothing if the texture is already loaded.
+ */
+void
+Loader::prefetchTexture(ResourceId id) {
+	SpecificLoader<sf::Texture>* loader = getSpecificLoader<sf::Texture>();
+	if (loader->isResident(id))
+		return;
+	PrefetchJob job;
+	job.id = id;
+	job.path = loader->getPath(id);
+	job.texture = true;
+	addJob(job);
+}
+
+/**
+ * Same as prefetchTexture, for an image with id.
+ */
+void
+Loader::prefetchImage(ResourceId id) {
+	SpecificLoader<sf::Image>* loader = getSpecificLoader<sf::Image>();
+	if (loader->isResident(id))
+		return;
+	PrefetchJob job;
+	job.id = id;
+	job.path = loader->getPath(id);
+	job.texture = false;
+	addJob(job);
+}
+
+/**
+ * Uploads all textures and stores all images that were decoded since the
+ * last call. Must be called from the thread that owns the OpenGL context.
+ */
+void
+Loader::update() {
+	std::deque<PrefetchJob> decoded;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		decoded.swap(mDecoded);
+	}
+	SpecificLoader<sf::Texture>* textures = getSpecificLoader<sf::Texture>();
+	SpecificLoader<sf::Image>* images = getSpecificLoader<sf::Image>();
+	for (auto& job : decoded) {
+		mPending--;
+		if (!job.loaded)
+			continue;
+		sf::Clock upload;
+		// Skipped if loaded synchronously in the meantime.
+		if (!job.texture) {
+			if (!images->isResident(job.id))
+				images->setResident(job.id,
+						std::make_shared<sf::Image>(std::move(job.image)), true);
+		}
+		else if (!textures->isResident(job.id)) {
+			auto texture = std::make_shared<sf::Texture>();
+			if (texture->loadFromImage(job.image))
+				textures->setResident(job.id, texture, true);
+		}
+		LOG_D_ALL("Prefetched " << ((job.texture) ? "texture " : "image ") << job.path
+				<< ": decoded in " << job.decodeTime.asMicroseconds() / 1000.0f
+				<< " ms, stored in " << upload.getElapsedTime().asMicroseconds() / 1000.0f
+				<< " ms");
+	}
+}
+
+/**
+ * Blocks until all files passed to prefetchTexture and prefetchImage are
+ * decoded, then calls update.
+ */
+void
+Loader::waitForPrefetch() {
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mJobDecoded.wait(lock, [this]() {
+			return (int) mDecoded.size() == mPending;
+		});
+	}
+	update();
+}
+
+/**
+ * Returns statistics about all resources loaded through this class.
+ */
+Loader::Stats
+Loader::getStats() const {
+	Stats stats = mStats;
+	stats.pending = mPending;
+	for (const auto& loader : mLoaders)
+		loader.second->addStats(stats);
+	return stats;
+}
+
+size_t
+Loader::getBytes(const sf::Texture& texture) {
+	return texture.getSize().x * texture.getSize().y * 4;
+}
+
+size_t
+Loader::getBytes(const sf::Image& image) {
+	return image.getSize().x * image.getSize().y * 4;
+}
+
+/**
+ * Queues job for the worker threads, starting one per core on first use.
+ */
+void
+Loader::addJob(const PrefetchJob& job) {
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mJobs.push_back(job);
+		if (mWorkers.empty()) {
+			unsigned int count = std::max(1u, std::thread::hardware_concurrency());
+			for (unsigned int i = 0; i < count; i++)
+				mWorkers.push_back(std::thread(&Loader::runWorker, this));
+		}
+	}
+	mPending++;
+	mJobAdded.notify_one();
+}
+
+/**
+ * Decodes files passed to addJob, until the Loader is destroyed.
+ */
+void
+Loader::runWorker() {
+	std::unique_lock<std::mutex> lock(mMutex);
+	while (true) {
+		mJobAdded.wait(lock, [this]() {
+			return mStopWorkers || !mJobs.empty();
+		});
+		if (mStopWorkers)
+			return;
+		PrefetchJob job = mJobs.front();
+		mJobs.pop_front();
+		lock.unlock();
+		sf::Clock decode;
+		job.loaded = job.image.loadFromFile(job.path);
+		job.decodeTime = decode.getElapsedTime();
+		if (!job.loaded)
+			LOG_W("Failed to prefetch " << job.path);
+		lock.lock();
+		mDecoded.push_back(std::move(job));
+		mJobDecoded.notify_all();
+	}
+}
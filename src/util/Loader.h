@@ -8,9 +8,18 @@
 #ifndef DG_LOADER_H_
 #define DG_LOADER_H_
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
 #include <Thor/Resources.hpp>
-
-#include "Singleton.h"
+
+#include "Singleton.h"
 
 /**
  * This class allows to set default resource folders and subfolders, which means that these
@@ -25,6 +34,11 @@
  * Any folder/file parameter can be a full path and is relative to the current directory,
  * or the directory set by the higher variables.
  *
+ * Each file gets a ResourceId the first time it is used, which can be kept to load it
+ * again without building its path. Textures and images can be decoded in advance on
+ * worker threads (one per core) with prefetchTexture and prefetchImage, so that they
+ * don't have to be read from disk when first used.
+ *
  * @code
  * Loader l;
  * l.setFolder("resources/");
@@ -41,6 +55,28 @@ private:
 	class ResourceManager;
 
 public:
+	/// Handle for a file of a specific resource type, valid for the whole program run.
+	typedef unsigned int ResourceId;
+
+	/**
+	 * Number and size of loaded resources, and how often they were requested.
+	 */
+	struct Stats {
+		/// Resources that are currently loaded.
+		int resident = 0;
+		/// Memory used by loaded textures and images, in bytes.
+		size_t residentBytes = 0;
+		/// Requests for resources that were already loaded or prefetched.
+		int hits = 0;
+		/// Requests that had to load from disk.
+		int misses = 0;
+		/// Textures and images waiting to be decoded or uploaded.
+		int pending = 0;
+	};
+
+public:
+	~Loader();
+
 	/**
 	 * Sets the general resource folder path.
 	 */
@@ -60,22 +96,65 @@ public:
 	 */
 	template <typename T> std::shared_ptr<T>
 	fromFile(const std::string& file) {
-		auto resourceKey = static_cast<SpecificLoader<T>* >(getLoader<T>().get())
-				->fromFile(mFolder, file);
-		return mResourceManager.acquire(resourceKey);
+		return fromId<T>(getId<T>(file));
+	}
+
+	/**
+	 * Returns the id of file, which stays the same for the whole program run.
+	 * Does not load the file.
+	 */
+	template <typename T> ResourceId
+	getId(const std::string& file) {
+		return getSpecificLoader<T>()->getId(mFolder, file);
 	}
 
+	/**
+	 * Returns the full path of the file with id.
+	 */
+	template <typename T> const std::string&
+	getPath(ResourceId id) {
+		return getSpecificLoader<T>()->getPath(id);
+	}
+
+	/**
+	 * Returns the resource with id, loading it if it is not loaded already.
+	 *
+	 * @throw thor::ResourceLoadingException If the file can't be loaded.
+	 */
+	template <typename T> std::shared_ptr<T>
+	fromId(ResourceId id) {
+		SpecificLoader<T>* loader = getSpecificLoader<T>();
+		std::shared_ptr<T> resource = loader->getResident(id);
+		if (resource) {
+			mStats.hits++;
+			return resource;
+		}
+		mStats.misses++;
+		resource = mResourceManager.acquire(loader->getKey(id));
+		loader->setResident(id, resource);
+		return resource;
+	}
+
+	void prefetchTexture(ResourceId id);
+	void prefetchImage(ResourceId id);
+	void update();
+	void waitForPrefetch();
+	Stats getStats() const;
+
 private:
 	/**
 	 * We need this to save templates of different types in the same container.
 	 */
 	class LoaderBase {
 	public:
+		virtual ~LoaderBase() = default;
 		virtual void setSubFolder(const std::string& path) = 0;
+		virtual void addStats(Stats& stats) const = 0;
 	};
 
 	/**
-	 * This class forwards the loading of each individual type to Thor.
+	 * This class forwards the loading of each individual type to Thor, and keeps track of
+	 * ids and loaded resources.
 	 */
 	template <typename T>
 	class SpecificLoader : public LoaderBase {
@@ -89,18 +168,107 @@ private:
 		}
 
 		/**
-		 * Loads a resource from file via Thor.
+		 * Returns the id of file, creating a new one if file was not used before.
 		 *
 		 * @param folder The general resource folder
 		 * @param file Path/name of the file within the resource subfolder.
 		 */
-		thor::ResourceKey<T>
-		fromFile(const std::string& folder, const std::string& file) {
-			return thor::Resources::fromFile<T>(folder + mSubfolder + file);
+		ResourceId
+		getId(const std::string& folder, const std::string& file) {
+			auto id = mIds.find(file);
+			if (id != mIds.end())
+				return id->second;
+			Slot slot;
+			slot.path = folder + mSubfolder + file;
+			slot.key = thor::Resources::fromFile<T>(slot.path);
+			mSlots.push_back(slot);
+			return mIds[file] = mSlots.size() - 1;
 		}
 
+		const std::string&
+		getPath(ResourceId id) const {
+			return mSlots.at(id).path;
+		}
+
+		/**
+		 * Returns the Thor key to load the resource with id.
+		 */
+		const thor::ResourceKey<T>&
+		getKey(ResourceId id) const {
+			return mSlots.at(id).key;
+		}
+
+		/**
+		 * Returns the resource with id if it is loaded, null otherwise. The resource
+		 * is no longer held after this if it was prefetched.
+		 */
+		std::shared_ptr<T>
+		getResident(ResourceId id) {
+			Slot& slot = mSlots.at(id);
+			std::shared_ptr<T> resource = slot.resident.lock();
+			slot.prefetched.reset();
+			return resource;
+		}
+
+		/**
+		 * Remembers that resource was loaded for id. It is released like any other
+		 * resource once it is no longer used, unless prefetched is true, in which case
+		 * it is held until the first call to getResident.
+		 */
+		void
+		setResident(ResourceId id, std::shared_ptr<T> resource, bool prefetched = false) {
+			Slot& slot = mSlots.at(id);
+			slot.resident = resource;
+			slot.bytes = getBytes(*resource);
+			if (prefetched)
+				slot.prefetched = resource;
+		}
+
+		bool
+		isResident(ResourceId id) const {
+			return !mSlots.at(id).resident.expired();
+		}
+
+		void
+		addStats(Stats& stats) const {
+			for (const auto& slot : mSlots)
+				if (!slot.resident.expired()) {
+					stats.resident++;
+					stats.residentBytes += slot.bytes;
+				}
+		}
+
+	private:
+		struct Slot {
+			std::string path;
+			thor::ResourceKey<T> key;
+			/// Not holding the resource, so that it is released when unused.
+			std::weak_ptr<T> resident;
+			/// Set for prefetched resources until their first use.
+			std::shared_ptr<T> prefetched;
+			size_t bytes = 0;
+		};
+
 	private:
 		std::string mSubfolder;
+		/// Id by file name as passed to getId.
+		std::unordered_map<std::string, ResourceId> mIds;
+		/// Indexed by id.
+		std::vector<Slot> mSlots;
+	};
+
+	/**
+	 * A file for which prefetchTexture or prefetchImage was called.
+	 */
+	struct PrefetchJob {
+		ResourceId id;
+		std::string path;
+		/// False if only the image is needed, without uploading a texture.
+		bool texture;
+		/// Decoded by a worker thread, uploaded by update.
+		sf::Image image;
+		bool loaded = false;
+		sf::Time decodeTime;
 	};
 
 private:
@@ -123,6 +291,21 @@ private:
 					(typeid(T), std::unique_ptr<LoaderBase>(new SpecificLoader<T>))).first).second;
 	};
 
+	template <typename T> SpecificLoader<T>*
+	getSpecificLoader() {
+		return static_cast<SpecificLoader<T>* >(getLoader<T>().get());
+	}
+
+	static size_t getBytes(const sf::Texture& texture);
+	static size_t getBytes(const sf::Image& image);
+	template <typename T> static size_t
+	getBytes(const T&) {
+		return 0;
+	}
+
+	void addJob(const PrefetchJob& job);
+	void runWorker();
+
 private:
 	class ResourceManager : public thor::MultiResourceCache {
 	public:
@@ -136,6 +319,21 @@ private:
 	std::string mFolder;
 	std::map<std::type_index, std::unique_ptr<LoaderBase> > mLoaders;
 	ResourceManager mResourceManager;
+	Stats mStats;
+
+	/// Decode prefetched files, started by the first call to addJob.
+	std::vector<std::thread> mWorkers;
+	bool mStopWorkers = false;
+	/// Guards mJobs and mDecoded.
+	std::mutex mMutex;
+	std::condition_variable mJobAdded;
+	std::condition_variable mJobDecoded;
+	/// Files waiting for a worker thread.
+	std::deque<PrefetchJob> mJobs;
+	/// Files decoded by a worker thread, waiting for update.
+	std::deque<PrefetchJob> mDecoded;
+	/// Number of files passed to addJob and not yet handled by update.
+	int mPending = 0;
 };
 
 #endif /* DG_LOADER_H_ */
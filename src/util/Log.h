@@ -8,52 +8,86 @@
 #ifndef DG_LOG_H_
 #define DG_LOG_H_
 
-#include <iostream>
+#include <ostream>
 
 #include <SFML/System/Vector2.hpp>
 #include <SFML/Graphics/Rect.hpp>
 
-#ifdef RELEASE
+#include "Logger.h"
 
-#define LOG_E(str)
-#define LOG_W(str)
-#define LOG_D(str)
-#define LOG_I(str)
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARNING 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
 
+/**
+ * \def LOG_LEVEL
+ * Messages above this level are removed at compile time. Defaults to
+ * nothing for release builds and everything otherwise.
+ */
+#ifndef LOG_LEVEL
+#ifdef RELEASE
+#define LOG_LEVEL LOG_LEVEL_NONE
 #else
+#define LOG_LEVEL LOG_LEVEL_DEBUG
+#endif
+#endif
 
 /**
  * Logging functions for different levels.
  *
+ * Messages are written by a background thread (see Logger). Each macro
+ * use logs at most LogSite::MAX_PER_SECOND messages per second, the
+ * number of dropped ones is added to the next message, or reported on its
+ * own once the site stops logging. LOG_D_ALL is not limited.
+ *
  * @code
  * LOG_E("something bad happened");
  * LOG_I(1 << 2 << 3 << "takeoff");
  * @endcode
  */
+#define DG_LOG(level, name, limited, str) do { \
+	if (level <= LOG_LEVEL) { \
+		static LogSite logSite(__FILE__, __LINE__, name, limited); \
+		if (logSite.allow()) { \
+			Logger::Message logMessage; \
+			logMessage << str; \
+			Logger::i().push(logSite, logMessage); \
+		} \
+	} \
+} while (false)
 
 /**
  * \def LOG_E(str)
- * Log an error to the error stream.
+ * Log an error.
  */
-#define LOG_E(str) std::cout << __FILE__ << ":" << __LINE__ << " " << "Error:   " << str << std::endl
+#define LOG_E(str) DG_LOG(LOG_LEVEL_ERROR, "Error:   ", true, str)
 
 /**
- * \def LOG_E(str)
- * Log a warning to the output stream.
+ * \def LOG_W(str)
+ * Log a warning.
  */
-#define LOG_W(str) std::cout << __FILE__ << ":" << __LINE__ << " " << "Warning: " << str << std::endl
+#define LOG_W(str) DG_LOG(LOG_LEVEL_WARNING, "Warning: ", true, str)
 
 /**
- * \def LOG_E(str)
- * Log a debug message to the output stream.
+ * \def LOG_D(str)
+ * Log a debug message.
  */
-#define LOG_D(str) std::cout << __FILE__ << ":" << __LINE__ << " " << "Debug:   " << str << std::endl
+#define LOG_D(str) DG_LOG(LOG_LEVEL_DEBUG, "Debug:   ", true, str)
 
 /**
- * \def LOG_E(str)
- * Log an info to the output stream.
+ * \def LOG_D_ALL(str)
+ * Log a debug message without limit. Only for messages that are logged a
+ * bounded number of times, like one per file at startup.
  */
-#define LOG_I(str) std::cout << __FILE__ << ":" << __LINE__ << " " << "Info:    " << str << std::endl
+#define LOG_D_ALL(str) DG_LOG(LOG_LEVEL_DEBUG, "Debug:   ", false, str)
+
+/**
+ * \def LOG_I(str)
+ * Log an info.
+ */
+#define LOG_I(str) DG_LOG(LOG_LEVEL_INFO, "Info:    ", true, str)
 
 /**
  * Adds an output operator specalization for sf::Vector2f.
@@ -93,6 +127,4 @@ operator<<(std::ostream& os, const sf::IntRect& rect) {
     return os;
 }
 
-#endif
-
 #endif /* DG_LOG_H_ */
@@ -0,0 +1,208 @@
+/*
+ * Logger.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "Logger.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+const int Logger::IDLE_INTERVAL;
+
+namespace {
+
+/**
+ * Returns a steady time in milliseconds.
+ */
+long long
+getMilliseconds() {
+	return std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+std::atomic<LogSite*> LogSite::sFirst{nullptr};
+
+/**
+ * Adds the site to the list of all sites.
+ *
+ * @param limited False to allow every message, for sites that only log a
+ * 				  bounded number of messages, like reports at startup.
+ */
+LogSite::LogSite(const char* file, int line, const char* level, bool limited) :
+		mFile(file),
+		mLine(line),
+		mLevel(level),
+		mLimited(limited),
+		mNext(sFirst.load()) {
+	while (!sFirst.compare_exchange_weak(mNext, this));
+}
+
+/**
+ * Returns true if a message may be logged now, false if the site already
+ * logged MAX_PER_SECOND messages within the last second.
+ */
+bool
+LogSite::allow() {
+	if (!mLimited)
+		return true;
+	long long now = getMilliseconds();
+	long long start = mWindowStart.load(std::memory_order_relaxed);
+	if (now - start >= 1000 && mWindowStart.compare_exchange_strong(start, now))
+		mCount = 0;
+	if (mCount.fetch_add(1, std::memory_order_relaxed) < MAX_PER_SECOND)
+		return true;
+	mSuppressed++;
+	return false;
+}
+
+/**
+ * Returns the number of messages that were not allowed since the last call.
+ */
+int
+LogSite::takeSuppressed() {
+	return mSuppressed.exchange(0);
+}
+
+Logger::Message::Message() :
+		std::ostream(&mBuffer) {
+}
+
+/**
+ * Characters beyond MESSAGE_SIZE are discarded by the default overflow.
+ */
+Logger::Message::Buffer::Buffer() {
+	setp(mText, mText + MESSAGE_SIZE);
+}
+
+size_t
+Logger::Message::Buffer::getLength() const {
+	return pptr() - pbase();
+}
+
+const char*
+Logger::Message::Buffer::getText() const {
+	return mText;
+}
+
+Logger::Logger() :
+		mSlots(new Slot[CAPACITY]) {
+	for (size_t i = 0; i < CAPACITY; i++)
+		mSlots[i].sequence = i;
+	mThread = std::thread(&Logger::run, this);
+}
+
+/**
+ * Writes all remaining messages and stops the background thread.
+ */
+Logger::~Logger() {
+	mRunning = false;
+	mThread.join();
+}
+
+/**
+ * Queues message from site to be written. Can be called from any thread.
+ */
+void
+Logger::push(LogSite& site, const Message& message) {
+	size_t position = mTail.load(std::memory_order_relaxed);
+	Slot* slot;
+	while (true) {
+		slot = &mSlots[position & (CAPACITY - 1)];
+		size_t sequence = slot->sequence.load(std::memory_order_acquire);
+		if (sequence == position) {
+			if (mTail.compare_exchange_weak(position, position + 1,
+					std::memory_order_relaxed))
+				break;
+		}
+		// Not yet read by the background thread, so the buffer is full.
+		else if (sequence < position) {
+			mDropped++;
+			return;
+		}
+		else
+			position = mTail.load(std::memory_order_relaxed);
+	}
+	slot->site = &site;
+	slot->suppressed = site.takeSuppressed();
+	slot->length = message.mBuffer.getLength();
+	std::memcpy(slot->text, message.mBuffer.getText(), slot->length);
+	slot->sequence.store(position + 1, std::memory_order_release);
+}
+
+/**
+ * Writes all messages that are currently in the buffer.
+ *
+ * @return True if anything was written.
+ */
+bool
+Logger::write() {
+	bool written = false;
+	while (true) {
+		Slot& slot = mSlots[mHead & (CAPACITY - 1)];
+		if (slot.sequence.load(std::memory_order_acquire) != mHead + 1)
+			break;
+		std::cout << slot.site->mFile << ":" << slot.site->mLine << " "
+				<< slot.site->mLevel;
+		std::cout.write(slot.text, slot.length);
+		if (slot.suppressed > 0)
+			std::cout << " (" << slot.suppressed << " similar messages suppressed)";
+		std::cout << '\n';
+		slot.sequence.store(mHead + CAPACITY, std::memory_order_release);
+		mHead++;
+		written = true;
+	}
+	int dropped = mDropped.exchange(0);
+	if (dropped > 0)
+		std::cout << "Logger: buffer full, dropped " << dropped << " messages\n";
+	if (written || dropped > 0)
+		std::cout.flush();
+	return written;
+}
+
+/**
+ * Reports messages that were suppressed and not yet added to a later
+ * message.
+ *
+ * @param all False to only report sites whose one second window has
+ * 			  passed, so that a site that is still logging adds the count to
+ * 			  its next message instead.
+ */
+void
+Logger::writeSuppressed(bool all) {
+	long long now = getMilliseconds();
+	bool written = false;
+	for (LogSite* site = LogSite::sFirst.load(); site; site = site->mNext) {
+		if (site->mSuppressed.load(std::memory_order_relaxed) == 0 ||
+				(!all && now - site->mWindowStart.load(std::memory_order_relaxed) < 1000))
+			continue;
+		int suppressed = site->takeSuppressed();
+		if (suppressed == 0)
+			continue;
+		std::cout << site->mFile << ":" << site->mLine << " " << site->mLevel
+				<< "(" << suppressed << " similar messages suppressed)\n";
+		written = true;
+	}
+	if (written)
+		std::cout.flush();
+}
+
+/**
+ * Writes messages until the Logger is destroyed, then writes those that
+ * are left.
+ */
+void
+Logger::run() {
+	while (mRunning) {
+		if (!write()) {
+			writeSuppressed(false);
+			std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_INTERVAL));
+		}
+	}
+	write();
+	writeSuppressed(true);
+}
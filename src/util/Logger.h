@@ -0,0 +1,138 @@
+/*
+ * Logger.h
+ *
+ *  Created on: 19.10.2026
+ */
+
+#ifndef DG_LOGGER_H_
+#define DG_LOGGER_H_
+
+#include <atomic>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+
+#include <SFML/System.hpp>
+
+#include "Singleton.h"
+
+/**
+ * A single use of a LOG_* macro. Limits how often it logs, so that a
+ * message repeated every frame does not flood the output.
+ *
+ * All sites are kept in a list, so that the Logger can report suppressed
+ * messages of sites that stopped logging.
+ */
+class LogSite {
+public:
+	LogSite(const char* file, int line, const char* level, bool limited);
+
+	bool allow();
+	int takeSuppressed();
+
+private:
+	friend class Logger;
+
+	/// Messages allowed per second, others are only counted.
+	static const int MAX_PER_SECOND = 10;
+
+	/// Most recently created site, the start of the list.
+	static std::atomic<LogSite*> sFirst;
+
+	const char* mFile;
+	int mLine;
+	const char* mLevel;
+	/// False if every message is allowed.
+	bool mLimited;
+	LogSite* mNext;
+	/// Start of the current one second window, in milliseconds.
+	std::atomic<long long> mWindowStart{0};
+	/// Messages in the current window.
+	std::atomic<int> mCount{0};
+	/// Messages dropped since the last one that was logged.
+	std::atomic<int> mSuppressed{0};
+};
+
+/**
+ * Writes messages from any thread to std::cout on a background thread.
+ *
+ * Messages are formatted into a fixed size buffer on the calling thread
+ * and put into a lock free ring buffer, the background thread adds the
+ * location and level and writes them out. Logging never blocks or
+ * allocates, if the buffer is full the message is dropped and counted.
+ *
+ * Use through the macros in Log.h.
+ */
+class Logger : public Singleton<Logger> {
+public:
+	/// Maximum length of a message, longer ones are cut off.
+	static const size_t MESSAGE_SIZE = 256;
+
+	/**
+	 * Stream that formats a message into a fixed size buffer.
+	 */
+	class Message : public std::ostream {
+	public:
+		Message();
+
+	private:
+		friend class Logger;
+
+		class Buffer : public std::streambuf {
+		public:
+			Buffer();
+			size_t getLength() const;
+			const char* getText() const;
+
+		private:
+			char mText[MESSAGE_SIZE];
+		};
+
+	private:
+		Buffer mBuffer;
+	};
+
+public:
+	~Logger();
+
+	void push(LogSite& site, const Message& message);
+
+private:
+	/**
+	 * For Singleton behaviour.
+	 */
+	Logger();
+	friend class Singleton<Logger>;
+
+	bool write();
+	void writeSuppressed(bool all);
+	void run();
+
+private:
+	/// Number of messages the buffer can hold, must be a power of two.
+	static const size_t CAPACITY = 1024;
+	/// Time in milliseconds the thread waits when there is nothing to write.
+	static const int IDLE_INTERVAL = 5;
+
+	struct Slot {
+		/// Equals the write position when free, one more when written.
+		std::atomic<size_t> sequence;
+		const LogSite* site;
+		int suppressed;
+		size_t length;
+		char text[MESSAGE_SIZE];
+	};
+
+	std::unique_ptr<Slot[]> mSlots;
+	/// Next position to write to, shared by all threads.
+	std::atomic<size_t> mTail{0};
+	/// Next position to read from, only used by the background thread.
+	size_t mHead = 0;
+	/// Messages that did not fit into the buffer.
+	std::atomic<int> mDropped{0};
+	std::atomic<bool> mRunning{true};
+	std::thread mThread;
+};
+
+#endif /* DG_LOGGER_H_ */
@@ -0,0 +1,123 @@
+/*
+ * Preloader.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "Preloader.h"
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+
+#include <dirent.h>
+
+#include "Loader.h"
+#include "Log.h"
+#include "Yaml.h"
+
+/**
+ * @param manifest YAML file listing files to read without decoding, in
+ * 				   "files" as paths relative to the current directory.
+ * @param textureFolder Folder in which Loader looks for textures.
+ */
+Preloader::Preloader(const std::string& manifest,
+		const std::string& textureFolder) :
+		mTextureFolder(textureFolder),
+		mFiles(Yaml(manifest).get("files", std::vector<std::string>())) {
+}
+
+/**
+ * Decodes images as sf::Image as well as sf::Texture, for use in a
+ * TextureAtlas.
+ */
+void
+Preloader::addImages(const std::vector<std::string>& images) {
+	mImages.insert(mImages.end(), images.begin(), images.end());
+}
+
+/**
+ * Loads everything and blocks until it is done. Must be called from the
+ * thread that owns the OpenGL context.
+ */
+void
+Preloader::run() {
+	sf::Clock total;
+	std::vector<std::string> configs = listFiles(Yaml::getFolder(), ".yaml");
+	std::set<std::string> textures;
+	for (const auto& config : configs) {
+		sf::Clock clock;
+		Yaml yaml(config);
+		std::string texture = yaml.get("texture", std::string());
+		if (!texture.empty())
+			textures.insert(texture);
+		for (const auto& atlas : yaml.get("atlas", std::vector<std::string>()))
+			textures.insert(atlas);
+		LOG_D_ALL("Preloaded config " << config << " in "
+				<< clock.getElapsedTime().asMicroseconds() / 1000.0f << " ms");
+	}
+
+	// Files in the manifest are loaded by libraries, not through Loader.
+	for (const auto& texture : listFiles(mTextureFolder, ".png"))
+		if (std::find(mFiles.begin(), mFiles.end(), mTextureFolder + texture) ==
+				mFiles.end())
+			textures.insert(texture);
+	for (const auto& texture : textures)
+		Loader::i().prefetchTexture(Loader::i().getId<sf::Texture>(texture));
+	std::set<std::string> images(mImages.begin(), mImages.end());
+	for (const auto& image : images)
+		Loader::i().prefetchImage(Loader::i().getId<sf::Image>(image));
+
+	// Done while the worker threads are decoding.
+	for (const auto& file : mFiles) {
+		sf::Clock clock;
+		if (readFile(file))
+			LOG_D_ALL("Preloaded file " << file << " in "
+					<< clock.getElapsedTime().asMicroseconds() / 1000.0f << " ms");
+		else
+			LOG_W("Failed to preload file " << file);
+	}
+	Loader::i().waitForPrefetch();
+	LOG_I("Preloaded " << configs.size() << " configs, " << textures.size()
+			<< " textures, " << images.size() << " images and " << mFiles.size()
+			<< " files in " << total.getElapsedTime().asMilliseconds() << " ms");
+}
+
+/**
+ * Returns the names of all files in folder that end with extension, sorted.
+ */
+std::vector<std::string>
+Preloader::listFiles(const std::string& folder, const std::string& extension) {
+	std::vector<std::string> files;
+	DIR* dir = opendir(folder.c_str());
+	if (!dir) {
+		LOG_W("Failed to list files in " << folder);
+		return files;
+	}
+	while (dirent* entry = readdir(dir)) {
+		std::string name = entry->d_name;
+		if (name.size() > extension.size() &&
+				name.compare(name.size() - extension.size(), extension.size(),
+						extension) == 0)
+			files.push_back(name);
+	}
+	closedir(dir);
+	std::sort(files.begin(), files.end());
+	return files;
+}
+
+/**
+ * Reads the whole file at path and discards it.
+ *
+ * @return False if the file can't be read.
+ */
+bool
+Preloader::readFile(const std::string& path) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return false;
+	char buffer[4096];
+	while (file.read(buffer, sizeof(buffer)))
+		;
+	return file.eof();
+}
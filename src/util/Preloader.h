@@ -0,0 +1,51 @@
+/*
+ * Preloader.h
+ *
+ *  Created on: 19.10.2026
+ */
+
+#ifndef DG_PRELOADER_H_
+#define DG_PRELOADER_H_
+
+#include <string>
+#include <vector>
+
+/**
+ * Loads files before the game starts, so that the first frames don't have
+ * to wait for the disk.
+ *
+ * All configs in the Yaml folder are parsed, and every texture they
+ * reference or that is in the texture folder is decoded through Loader, in
+ * parallel on all cores. Files that libraries load by path (like the light
+ * shader) are listed in the manifest and read once, so that they are in the
+ * operating system's file cache. The time taken for each file is logged.
+ *
+ * @code
+ * Preloader preloader("preload.yaml", "res/textures/");
+ * preloader.addImages(World::getAtlasFiles());
+ * preloader.run();
+ * @endcode
+ */
+class Preloader {
+public:
+	explicit Preloader(const std::string& manifest,
+			const std::string& textureFolder);
+
+	void addImages(const std::vector<std::string>& images);
+	void run();
+
+private:
+	static std::vector<std::string> listFiles(const std::string& folder,
+			const std::string& extension);
+	static bool readFile(const std::string& path);
+
+private:
+	/// Folder containing the textures, the same as used by Loader.
+	std::string mTextureFolder;
+	/// Files to read without decoding, from the manifest.
+	std::vector<std::string> mFiles;
+	/// Textures that are also needed as sf::Image.
+	std::vector<std::string> mImages;
+};
+
+#endif /* DG_PRELOADER_H_ */
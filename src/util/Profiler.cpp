@@ -0,0 +1,166 @@
+/*
+ * Profiler.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "Profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+std::atomic<bool> Profiler::mEnabled{false};
+const std::chrono::steady_clock::time_point Profiler::mEpoch =
+		std::chrono::steady_clock::now();
+
+ProfileZone::ProfileZone(const char* name) :
+		mName(name),
+		mStart((Profiler::isEnabled()) ? Profiler::now() : 0) {
+}
+
+ProfileZone::~ProfileZone() {
+	if (mStart != 0)
+		Profiler::i().add(mName, mStart, Profiler::now());
+}
+
+/**
+ * Returns true if zones are measured.
+ */
+bool
+Profiler::isEnabled() {
+	return mEnabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Starts or stops measuring zones. Averages and captured frames are kept
+ * while disabled.
+ */
+void
+Profiler::setEnabled(bool enabled) {
+	mEnabled = enabled;
+}
+
+/**
+ * Collects the samples of all threads into the current frame and starts a
+ * new one. Call once per frame, from the main thread.
+ */
+void
+Profiler::nextFrame() {
+	if (!isEnabled())
+		return;
+	std::vector<Sample> frame;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		for (auto& thread : mThreads) {
+			std::lock_guard<std::mutex> threadLock(thread->mutex);
+			frame.insert(frame.end(), thread->samples.begin(),
+					thread->samples.end());
+			thread->samples.clear();
+		}
+	}
+
+	for (auto& zone : mZones) {
+		zone.second.durations[mFrame] = 0;
+		zone.second.calls[mFrame] = 0;
+	}
+	for (const auto& sample : frame) {
+		Zone& zone = mZones[sample.name];
+		zone.durations[mFrame] += sample.duration;
+		zone.calls[mFrame]++;
+	}
+	mFrame = (mFrame + 1) % HISTORY;
+
+	mCapture.push_back(std::move(frame));
+	if (mCapture.size() > CAPTURE_FRAMES)
+		mCapture.pop_front();
+}
+
+/**
+ * Returns the average time and calls per frame of each zone, slowest first.
+ */
+std::vector<Profiler::ZoneStats>
+Profiler::getStats() const {
+	std::vector<ZoneStats> stats;
+	for (const auto& zone : mZones) {
+		std::uint64_t duration = 0;
+		int calls = 0;
+		for (size_t i = 0; i < HISTORY; i++) {
+			duration += zone.second.durations[i];
+			calls += zone.second.calls[i];
+		}
+		ZoneStats s;
+		s.name = zone.first;
+		s.milliseconds = duration / 1000000.0f / HISTORY;
+		s.calls = calls / (float) HISTORY;
+		stats.push_back(s);
+	}
+	std::sort(stats.begin(), stats.end(),
+			[](const ZoneStats& a, const ZoneStats& b) {
+				return a.milliseconds > b.milliseconds;
+			});
+	return stats;
+}
+
+/**
+ * Writes the zones of the last CAPTURE_FRAMES frames in the Chrome trace
+ * event format.
+ *
+ * @return False if the file can't be written.
+ */
+bool
+Profiler::exportChromeTrace(const std::string& path) const {
+	std::ofstream file(path);
+	if (!file)
+		return false;
+	// Keep nanosecond resolution, the default precision switches to
+	// exponent notation after one second.
+	file << std::fixed << std::setprecision(3);
+	file << "{\"traceEvents\":[";
+	bool first = true;
+	for (const auto& frame : mCapture)
+		for (const auto& sample : frame) {
+			if (!first)
+				file << ",";
+			first = false;
+			// Complete events, times are in microseconds.
+			file << "\n{\"name\":\"" << sample.name << "\",\"ph\":\"X\",\"pid\":1,"
+					<< "\"tid\":" << sample.thread << ","
+					<< "\"ts\":" << sample.start / 1000.0 << ","
+					<< "\"dur\":" << sample.duration / 1000.0 << "}";
+		}
+	file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	return file.good();
+}
+
+/**
+ * Returns nanoseconds since the Profiler was created, at least 1.
+ */
+std::uint64_t
+Profiler::now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - mEpoch).count() + 1;
+}
+
+void
+Profiler::add(const char* name, std::uint64_t start, std::uint64_t end) {
+	ThreadBuffer& buffer = getThreadBuffer();
+	Sample sample = {name, start, end - start, buffer.thread};
+	std::lock_guard<std::mutex> lock(buffer.mutex);
+	buffer.samples.push_back(sample);
+}
+
+/**
+ * Returns the buffer of the calling thread, creating it on first use.
+ */
+Profiler::ThreadBuffer&
+Profiler::getThreadBuffer() {
+	thread_local ThreadBuffer* buffer = nullptr;
+	if (!buffer) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mThreads.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer()));
+		buffer = mThreads.back().get();
+		buffer->thread = mThreads.size();
+	}
+	return *buffer;
+}
@@ -0,0 +1,147 @@
+/*
+ * Profiler.h
+ *
+ *  Created on: 19.10.2026
+ */
+
+#ifndef DG_PROFILER_H_
+#define DG_PROFILER_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <SFML/System.hpp>
+
+#include "Singleton.h"
+
+/**
+ * Measures the time between its construction and destruction, if the
+ * Profiler is enabled.
+ *
+ * @code
+ * void
+ * World::step(int elapsed) {
+ * 	ProfileZone zone("World::step");
+ * 	...
+ * }
+ * @endcode
+ */
+class ProfileZone : public sf::NonCopyable {
+public:
+	/**
+	 * @param name Must stay valid for the whole program run, usually a
+	 * 			   string literal.
+	 */
+	explicit ProfileZone(const char* name);
+	~ProfileZone();
+
+private:
+	const char* mName;
+	/// Zero if the Profiler was disabled on construction.
+	std::uint64_t mStart;
+};
+
+/**
+ * Collects the times measured by ProfileZone on any thread.
+ *
+ * Each thread writes into its own buffer, which nextFrame empties once per
+ * frame to update the average time of each zone over the last HISTORY
+ * frames. The zones of the last CAPTURE_FRAMES frames are kept for
+ * exportChromeTrace, the result can be opened in chrome://tracing.
+ *
+ * Disabled by default, zones only check a flag then.
+ */
+class Profiler : public Singleton<Profiler> {
+public:
+	/**
+	 * Averages of a single zone.
+	 */
+	struct ZoneStats {
+		std::string name;
+		/// Total time in the zone per frame, in milliseconds.
+		float milliseconds;
+		/// Number of times the zone was entered per frame.
+		float calls;
+	};
+
+public:
+	static bool isEnabled();
+	void setEnabled(bool enabled);
+	void nextFrame();
+	std::vector<ZoneStats> getStats() const;
+	bool exportChromeTrace(const std::string& path) const;
+
+private:
+	/// Frames over which zone times are averaged.
+	static const size_t HISTORY = 60;
+	/// Frames kept for exportChromeTrace.
+	static const size_t CAPTURE_FRAMES = 300;
+
+	/**
+	 * A single measurement of a ProfileZone.
+	 */
+	struct Sample {
+		const char* name;
+		/// Nanoseconds since the Profiler was created.
+		std::uint64_t start;
+		std::uint64_t duration;
+		unsigned int thread;
+	};
+
+	/**
+	 * Samples of a single thread, since the last call to nextFrame.
+	 */
+	struct ThreadBuffer {
+		unsigned int thread;
+		/// Only contended while nextFrame collects the samples.
+		std::mutex mutex;
+		std::vector<Sample> samples;
+	};
+
+	/**
+	 * Totals of a zone for each of the last HISTORY frames.
+	 */
+	struct Zone {
+		std::array<std::uint64_t, HISTORY> durations{};
+		std::array<int, HISTORY> calls{};
+	};
+
+private:
+	/**
+	 * For Singleton behaviour.
+	 */
+	Profiler() = default;
+	friend class Singleton<Profiler>;
+	friend class ProfileZone;
+
+	static std::uint64_t now();
+	void add(const char* name, std::uint64_t start, std::uint64_t end);
+	ThreadBuffer& getThreadBuffer();
+
+private:
+	static std::atomic<bool> mEnabled;
+	static const std::chrono::steady_clock::time_point mEpoch;
+
+	/// Guards mThreads.
+	mutable std::mutex mMutex;
+	/// Buffers of all threads that ever entered a zone, never removed so
+	/// that they outlive their thread.
+	std::vector<std::unique_ptr<ThreadBuffer> > mThreads;
+
+	/// Keyed by name instead of pointer, as equal literals may differ.
+	std::map<std::string, Zone> mZones;
+	/// Position in each Zone's arrays for the current frame.
+	size_t mFrame = 0;
+	/// Samples of the last CAPTURE_FRAMES frames, oldest first.
+	std::deque<std::vector<Sample> > mCapture;
+};
+
+#endif /* DG_PROFILER_H_ */
@@ -0,0 +1,99 @@
+/*
+ * TextureAtlas.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "Log.h"
+
+/**
+ * Loads all files and packs them into rows (sorted by height), each at most
+ * MAX_WIDTH pixels wide. Files that fail to load are skipped with a warning.
+ *
+ * @param files Names of the images to pack, relative to the sf::Image
+ * 				subfolder set in Loader.
+ */
+TextureAtlas::TextureAtlas(const std::vector<std::string>& files) {
+	typedef std::pair<Loader::ResourceId, std::shared_ptr<sf::Image> > Image;
+	std::vector<Image> images;
+	for (const auto& file : files) {
+		Loader::ResourceId id = Loader::i().getId<sf::Texture>(file);
+		if (contains(id))
+			continue;
+		try {
+			images.push_back(std::make_pair(id,
+					Loader::i().fromFile<sf::Image>(file)));
+			if (mContains.size() <= id) {
+				mRects.resize(id + 1);
+				mContains.resize(id + 1, false);
+			}
+			mContains[id] = true;
+		}
+		catch (thor::ResourceLoadingException&) {
+			LOG_W("Failed to load texture " << file << " for atlas.");
+		}
+	}
+	std::sort(images.begin(), images.end(),
+			[](const Image& a, const Image& b) {
+				return a.second->getSize().y > b.second->getSize().y;
+			});
+
+	// Place images left to right, starting a new row when one is full.
+	unsigned int x = 0;
+	unsigned int y = 0;
+	unsigned int rowHeight = 0;
+	unsigned int width = 0;
+	for (const auto& image : images) {
+		sf::Vector2u size = image.second->getSize();
+		if (x != 0 && x + size.x + 2 * PADDING > MAX_WIDTH) {
+			x = 0;
+			y += rowHeight;
+			rowHeight = 0;
+		}
+		mRects[image.first] = sf::IntRect(x + PADDING, y + PADDING, size.x, size.y);
+		x += size.x + 2 * PADDING;
+		rowHeight = std::max(rowHeight, size.y + 2 * PADDING);
+		width = std::max(width, x);
+	}
+
+	sf::Image atlas;
+	atlas.create(std::max(width, 1u), std::max(y + rowHeight, 1u),
+			sf::Color::Transparent);
+	for (const auto& image : images) {
+		const sf::IntRect& rect = mRects[image.first];
+		atlas.copy(*image.second, rect.left, rect.top);
+	}
+	mTexture.loadFromImage(atlas);
+}
+
+/**
+ * Returns the texture containing all packed images.
+ */
+const sf::Texture&
+TextureAtlas::getTexture() const {
+	return mTexture;
+}
+
+/**
+ * Returns the pixel rectangle of texture within the atlas, or an empty
+ * rectangle if texture is not part of the atlas.
+ */
+sf::IntRect
+TextureAtlas::getRect(Loader::ResourceId texture) const {
+	return (contains(texture))
+			? mRects[texture]
+			: sf::IntRect();
+}
+
+/**
+ * Returns true if texture was packed into the atlas.
+ */
+bool
+TextureAtlas::contains(Loader::ResourceId texture) const {
+	return texture < mContains.size() && mContains[texture];
+}
@@ -0,0 +1,52 @@
+/*
+ * TextureAtlas.h
+ *
+ *  Created on: 19.10.2026
+ */
+
+#ifndef DG_TEXTUREATLAS_H_
+#define DG_TEXTUREATLAS_H_
+
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include "Loader.h"
+
+/**
+ * Packs multiple texture files into a single texture, so that sprites using
+ * any of them can be drawn with a single draw call.
+ *
+ * Images are loaded through Loader, so file names are the same as for
+ * textures. Rects are looked up by the texture's ResourceId, as stored
+ * in Sprite.
+ *
+ * @code
+ * TextureAtlas atlas({"floor.png", "wall.png"});
+ * sf::IntRect wall = atlas.getRect(Loader::i().getId<sf::Texture>("wall.png"));
+ * states.texture = &atlas.getTexture();
+ * @endcode
+ */
+class TextureAtlas {
+public:
+	explicit TextureAtlas(const std::vector<std::string>& files);
+
+	const sf::Texture& getTexture() const;
+	sf::IntRect getRect(Loader::ResourceId texture) const;
+	bool contains(Loader::ResourceId texture) const;
+
+private:
+	/// Maximum width of the packed texture in pixels.
+	static const unsigned int MAX_WIDTH = 1024;
+	/// Transparent pixels around each image, to avoid bleeding when drawing.
+	static const unsigned int PADDING = 1;
+
+	sf::Texture mTexture;
+	/// Indexed by texture id, empty for textures that are not packed.
+	std::vector<sf::IntRect> mRects;
+	/// Indexed by texture id.
+	std::vector<bool> mContains;
+};
+
+#endif /* DG_TEXTUREATLAS_H_ */
@@ -0,0 +1,141 @@
+/*
+ * Trace.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include "Trace.h"
+
+#include <utility>
+
+#include "Log.h"
+
+const char Trace::MAGIC[4] = {'D', 'G', 'T', 'R'};
+std::atomic<bool> Trace::mEnabled{false};
+
+Trace::~Trace() {
+	stop();
+}
+
+/**
+ * Starts recording events into a new file at path. Does nothing if already
+ * started.
+ *
+ * @return False if the file can't be created.
+ */
+bool
+Trace::start(const std::string& path) {
+	if (mEnabled)
+		return true;
+	mFile.open(path, std::ios::binary | std::ios::trunc);
+	if (!mFile) {
+		LOG_W("Failed to create trace file " << path);
+		return false;
+	}
+	Header header = {{MAGIC[0], MAGIC[1], MAGIC[2], MAGIC[3]}, VERSION,
+			sizeof(Record)};
+	mFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	// Enough for the thread to fall behind by a few buffers.
+	mCurrent.reserve(BUFFER_SIZE);
+	mFree.resize(3);
+	for (auto& buffer : mFree)
+		buffer.reserve(BUFFER_SIZE);
+	mStart = std::chrono::steady_clock::now();
+	mFrame = 0;
+	mStopThread = false;
+	mThread = std::thread(&Trace::run, this);
+	mEnabled = true;
+	LOG_I("Tracing events to " << path);
+	return true;
+}
+
+/**
+ * Writes all recorded events and closes the file.
+ */
+void
+Trace::stop() {
+	if (!mEnabled)
+		return;
+	mEnabled = false;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mStopThread = true;
+		if (!mCurrent.empty()) {
+			mFull.push_back(std::move(mCurrent));
+			mCurrent.clear();
+		}
+	}
+	mBufferFull.notify_one();
+	mThread.join();
+	mFile.close();
+	mFree.clear();
+}
+
+/**
+ * Marks the start of a new frame, which takes all following events.
+ *
+ * @param elapsed Time since the last frame in milliseconds.
+ */
+void
+Trace::nextFrame(int elapsed) {
+	if (!isEnabled())
+		return;
+	mFrame++;
+	add(FRAME, elapsed, 0, 0, 0);
+}
+
+void
+Trace::add(Event type, std::int32_t first, std::int32_t second, float x, float y) {
+	Record record;
+	record.time = std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - mStart).count();
+	record.frame = mFrame;
+	record.type = type;
+	record.padding = 0;
+	record.first = first;
+	record.second = second;
+	record.x = x;
+	record.y = y;
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (mCurrent.size() == BUFFER_SIZE) {
+		if (mFree.empty()) {
+			mDropped++;
+			return;
+		}
+		mFull.push_back(std::move(mCurrent));
+		mCurrent = std::move(mFree.back());
+		mFree.pop_back();
+		mBufferFull.notify_one();
+	}
+	mCurrent.push_back(record);
+}
+
+/**
+ * Writes full buffers to the file until stop is called, then writes the
+ * remaining ones.
+ */
+void
+Trace::run() {
+	std::unique_lock<std::mutex> lock(mMutex);
+	while (true) {
+		mBufferFull.wait(lock, [this]() {
+			return mStopThread || !mFull.empty();
+		});
+		if (mFull.empty())
+			return;
+		std::vector<Record> buffer = std::move(mFull.front());
+		mFull.erase(mFull.begin());
+		int dropped = mDropped;
+		mDropped = 0;
+		lock.unlock();
+		mFile.write(reinterpret_cast<const char*>(buffer.data()),
+				buffer.size() * sizeof(Record));
+		if (dropped > 0)
+			LOG_W("Trace buffers full, dropped " << dropped << " events");
+		buffer.clear();
+		lock.lock();
+		mFree.push_back(std::move(buffer));
+	}
+}
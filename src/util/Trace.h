@@ -0,0 +1,144 @@
+/*
+ * Trace.h
+ *
+ *  Created on: 19.10.2026
+ */
+
+#ifndef DG_TRACE_H_
+#define DG_TRACE_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SFML/System.hpp>
+
+#include "Singleton.h"
+
+/**
+ * Records gameplay and engine events into a binary file, for analysing
+ * sessions afterwards with tools/TraceStats.cpp.
+ *
+ * Tracing is off unless start is called. Events are collected in
+ * preallocated buffers, full buffers are written by a background thread.
+ * If the thread can't keep up, events are dropped and counted.
+ *
+ * The file starts with a Header, followed by Records until the end.
+ *
+ * @code
+ * Trace::i().start("session.trace");
+ * Trace::i().nextFrame(elapsed); // once per frame
+ * Trace::record(Trace::DEATH, character.getId(), 0, position.x, position.y);
+ * Trace::i().stop();
+ * @endcode
+ */
+class Trace : public Singleton<Trace> {
+public:
+	/**
+	 * Types of events, with the meaning of their values.
+	 */
+	enum Event : std::uint16_t {
+		FRAME, //< first: elapsed milliseconds since the previous frame.
+		COLLISION, //< first, second: sprite ids, x/y: position of first.
+		BULLET_HIT, //< first: shooter id, second: sprite id (0 for walls), x/y: position.
+		DAMAGE, //< first: character id, x: damage, y: health afterwards.
+		DEATH, //< first: character id, x/y: position.
+		FIRE, //< first: character id, second: bullets fired, x/y: position.
+		GENERATE_TILES, //< first/second: area position in tiles, x: duration in milliseconds.
+		PATH, //< first: points in the path (0 if none), x: duration in microseconds, y: distance.
+		EVENT_COUNT
+	};
+
+	/**
+	 * A single event, as written to the file.
+	 */
+	struct Record {
+		/// Microseconds since start was called.
+		std::uint64_t time;
+		std::uint32_t frame;
+		std::uint16_t type;
+		std::uint16_t padding;
+		std::int32_t first;
+		std::int32_t second;
+		float x;
+		float y;
+	};
+	static_assert(sizeof(Record) == 32, "Trace records must be 32 bytes");
+
+	/**
+	 * Start of each trace file.
+	 */
+	struct Header {
+		char magic[4];
+		std::uint32_t version;
+		std::uint32_t recordSize;
+	};
+
+	static const char MAGIC[4];
+	static const std::uint32_t VERSION = 1;
+
+public:
+	~Trace();
+
+	bool start(const std::string& path);
+	void stop();
+	void nextFrame(int elapsed);
+
+	/**
+	 * Returns true if events are currently recorded.
+	 */
+	static bool
+	isEnabled() {
+		return mEnabled.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Records an event if tracing is enabled. Can be called from any thread.
+	 */
+	static void
+	record(Event type, std::int32_t first, std::int32_t second, float x, float y) {
+		if (isEnabled())
+			i().add(type, first, second, x, y);
+	}
+
+private:
+	/**
+	 * For Singleton behaviour.
+	 */
+	Trace() = default;
+	friend class Singleton<Trace>;
+
+	void add(Event type, std::int32_t first, std::int32_t second, float x, float y);
+	void run();
+
+private:
+	/// Records per buffer.
+	static const size_t BUFFER_SIZE = 4096;
+
+	static std::atomic<bool> mEnabled;
+	std::ofstream mFile;
+	std::chrono::steady_clock::time_point mStart;
+	std::atomic<std::uint32_t> mFrame{0};
+
+	std::thread mThread;
+	bool mStopThread = false;
+	/// Guards everything below.
+	std::mutex mMutex;
+	std::condition_variable mBufferFull;
+	/// Buffer events are added to.
+	std::vector<Record> mCurrent;
+	/// Buffers waiting to be written by the thread.
+	std::vector<std::vector<Record> > mFull;
+	/// Empty buffers, allocated by start.
+	std::vector<std::vector<Record> > mFree;
+	/// Events that were dropped since the last warning.
+	int mDropped = 0;
+};
+
+#endif /* DG_TRACE_H_ */
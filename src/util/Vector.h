@@ -8,6 +8,8 @@
 #ifndef DG_VECTOR_H_
 #define DG_VECTOR_H_
 
+#include <functional>
+
 #include <SFML/System.hpp>
 
 #include <LTBL/Constructs/Vec2f.h>
@@ -50,6 +52,18 @@ bool operator <(const Vector2<T>& left, const Vector2<T>& right) {
 	return left.x < right.x || (left.x == right.x && left.y < right.y);
 }
 
+/**
+ * Hash function meant for containers like std::unordered_map.
+ */
+namespace std {
+template <typename T>
+struct hash<Vector2<T> > {
+	size_t operator()(const Vector2<T>& v) const {
+		return hash<T>()(v.x) * 31 + hash<T>()(v.y);
+	}
+};
+}
+
 typedef Vector2<int> Vector2i;
 typedef Vector2<float> Vector2f;
 
@@ -10,15 +10,34 @@
 #include "../util/Log.h"
 
 std::string Yaml::mFolder = "";
+std::unordered_map<std::string, std::shared_ptr<const YAML::Node> > Yaml::mCache;
+int Yaml::mParseCount = 0;
+int Yaml::mCacheHitCount = 0;
+int Yaml::mBundleReadCount = 0;
+ConfigBundle Yaml::mBundle;
 
 /**
  * Creates a readable object from a YAML file. The path must be relative to the directory
- * set in setFolder().
+ * set in setFolder(). The file is only parsed if it was not loaded before.
  */
 Yaml::Yaml(const std::string& filename) :
 		mFilename(filename) {
-	mNode = YAML::LoadFile(mFolder + filename);
-	if (mNode.IsNull())
+	std::shared_ptr<const YAML::Node>& cached = mCache[mFolder + filename];
+	if (cached) {
+		mCacheHitCount++;
+		mNode = cached;
+		return;
+	}
+	YAML::Node node;
+	if (mBundle.getNode(filename, node))
+		mBundleReadCount++;
+	else {
+		mParseCount++;
+		node = YAML::LoadFile(mFolder + filename);
+	}
+	mNode = std::make_shared<const YAML::Node>(node);
+	cached = mNode;
+	if (mNode->IsNull())
 		LOG_D("Failed to load config file " << mFolder << filename);
 }
 
@@ -30,3 +49,66 @@ void
 Yaml::setFolder(const std::string& folder) {
 	mFolder = folder;
 }
+
+std::string
+Yaml::getFolder() {
+	return mFolder;
+}
+
+/**
+ * Replaces the cached document for filename, which is used by Yaml objects
+ * created afterwards. Existing Yaml objects keep the old document.
+ */
+void
+Yaml::replace(const std::string& filename, const YAML::Node& node) {
+	mCache[mFolder + filename] = std::make_shared<const YAML::Node>(node);
+}
+
+/**
+ * Reads files from the bundle at path instead of parsing them, as long as
+ * the bundle contains them. Files that are not in the bundle are still
+ * parsed. The bundle is not compared with the YAML files, so main only
+ * loads it in release builds.
+ *
+ * @return False if the bundle does not exist or can't be used, all files
+ * 		   are parsed in that case.
+ */
+bool
+Yaml::loadBundle(const std::string& path) {
+	return mBundle.load(path);
+}
+
+/**
+ * Forgets all parsed files, so they are read again on the next use. Existing
+ * Yaml objects keep their values.
+ */
+void
+Yaml::clearCache() {
+	mCache.clear();
+}
+
+/**
+ * Returns the number of files that were parsed so far, not including those
+ * read from the bundle.
+ */
+int
+Yaml::getParseCount() {
+	return mParseCount;
+}
+
+/**
+ * Returns the number of times a file was taken from the cache instead of
+ * being parsed.
+ */
+int
+Yaml::getCacheHitCount() {
+	return mCacheHitCount;
+}
+
+/**
+ * Returns the number of files that were read from the bundle.
+ */
+int
+Yaml::getBundleReadCount() {
+	return mBundleReadCount;
+}
@@ -10,28 +10,48 @@
 
 #include <string>
 #include <fstream>
+#include <memory>
+#include <unordered_map>
 
 #include <yaml-cpp/yaml.h>
 
+#include "ConfigBundle.h"
 #include "Log.h"
 #include "Vector.h"
 
 /**
  * Interface to a YAML file.
+ *
+ * Each file is only parsed once, all Yaml objects for the same file share
+ * the same document, which is never modified. If a bundle was loaded with
+ * loadBundle, files are taken from it instead of being parsed.
  */
 class Yaml {
 public:
 	explicit Yaml(const std::string& filename);
 
 	static void setFolder(const std::string& folder);
+	static bool loadBundle(const std::string& path);
+	static std::string getFolder();
+	static void replace(const std::string& filename, const YAML::Node& node);
+	static void clearCache();
+	static int getParseCount();
+	static int getCacheHitCount();
+	static int getBundleReadCount();
 
 	template <typename T>
 	T get(const std::string& key, const T& defaultValue) const;
 
 private:
 	static std::string mFolder;
+	/// Parsed documents by full path.
+	static std::unordered_map<std::string, std::shared_ptr<const YAML::Node> > mCache;
+	static int mParseCount;
+	static int mCacheHitCount;
+	static int mBundleReadCount;
+	static ConfigBundle mBundle;
 	std::string mFilename;
-	YAML::Node mNode;
+	std::shared_ptr<const YAML::Node> mNode;
 };
 
 /**
@@ -72,8 +92,9 @@ struct convert<Vector2i> {
  */
 template <typename T>
 T Yaml::get(const std::string& key, const T& defaultValue) const {
-    if(mNode[key])
-    	return mNode[key].as<T>();
+    const YAML::Node value = (*mNode)[key];
+    if(value)
+    	return value.as<T>();
     else
     	return defaultValue;
 };
@@ -0,0 +1,189 @@
+/*
+ * BodyBenchmark.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <Thor/Vectors.hpp>
+
+#include "../src/BodyStore.h"
+#include "../src/World.h"
+#include "../src/sprites/abstract/Circle.h"
+#include "../src/util/Loader.h"
+#include "../src/util/Yaml.h"
+
+/**
+ * A moving sprite as it was stored before BodyStore owned positions and
+ * speeds: its own heap object, with the position inside the shape.
+ */
+struct OldBody {
+	sf::RectangleShape shape;
+	Vector2f speed;
+};
+
+/**
+ * Circle that can be moved from outside, like World moves its sprites.
+ */
+class Body : public Circle {
+public:
+	using Circle::Circle;
+	using Sprite::setPosition;
+	using Sprite::setSpeed;
+};
+
+/// Number of moving bodies.
+static const int BODIES = 10000;
+/// Number of steps that are timed.
+static const int STEPS = 1000;
+/// Duration of a step in seconds.
+static const float STEP_SECONDS = 0.016f;
+/// Number of sprites in the collision benchmark, every second one moves.
+static const int COLLISION_BODIES = 2000;
+/// Number of steps that are timed in the collision benchmark.
+static const int COLLISION_STEPS = 20;
+
+/**
+ * Returns milliseconds per step for calling step steps times.
+ */
+template <typename F>
+double
+measure(F step, int steps) {
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < steps; i++)
+		step();
+	return std::chrono::duration<double, std::milli>(
+			std::chrono::steady_clock::now() - start).count() / steps;
+}
+
+/**
+ * Moves sprites, of which every second one is moving, like World::step did
+ * before BodyStore: each moving sprite is tested against every sprite in
+ * the world and then moved on its own.
+ */
+void
+stepOld(const std::vector<std::shared_ptr<Body> >& sprites) {
+	for (const auto& sprite : sprites) {
+		if (sprite->getSpeed() == Vector2f())
+			continue;
+		Vector2f offset = sprite->getSpeed() * STEP_SECONDS;
+		for (const auto& other : sprites) {
+			if (sprite == other ||
+					!sprite->collisionEnabled(other->getCategory()) ||
+					!other->collisionEnabled(sprite->getCategory()))
+				continue;
+			if (sprite->testCollision(other, offset,
+					other->getSpeed() * STEP_SECONDS)) {
+				sprite->onCollide(other);
+				other->onCollide(sprite);
+			}
+		}
+		sprite->setPosition(sprite->getPosition() + offset);
+	}
+}
+
+/**
+ * Moves BODIES bodies without collisions, once stored as separate heap
+ * objects and updated one at a time like World::step did before, and once
+ * in a BodyStore.
+ *
+ * Then steps COLLISION_BODIES colliding sprites, half of them moving, once
+ * with the brute force collision tests World::step did before, and once with
+ * World::step. Collisions of two moving sprites are counted differently, so
+ * the positions are not compared.
+ *
+ * Built separately from the game, together with all files in src except
+ * main.cpp, and run from the game's folder.
+ *
+ * @code
+ * BodyBenchmark
+ * @endcode
+ */
+int main() {
+	Yaml::setFolder("res/yaml/");
+	Loader::i().setFolder("res/");
+	Loader::i().setSubFolder<sf::Texture>("textures/");
+	Loader::i().setSubFolder<sf::Image>("textures/");
+	Loader::ResourceId texture = Loader::i().getId<sf::Texture>("bullet.png");
+
+	std::default_random_engine generator;
+	std::uniform_real_distribution<float> position(-5000.0f, 5000.0f);
+	std::uniform_real_distribution<float> speed(-500.0f, 500.0f);
+	std::vector<std::shared_ptr<OldBody> > oldBodies;
+	std::vector<std::shared_ptr<Sprite> > sprites;
+	BodyStore store;
+	for (int i = 0; i < BODIES; i++) {
+		Vector2f p(position(generator), position(generator));
+		Vector2f v(speed(generator), speed(generator));
+		auto old = std::make_shared<OldBody>();
+		old->shape.setSize(Vector2f(10, 10));
+		old->shape.setPosition(p);
+		old->speed = v;
+		oldBodies.push_back(old);
+		auto sprite = std::make_shared<Circle>(p, Sprite::CATEGORY_PARTICLE,
+				Sprite::MASK_NONE, Vector2f(10, 10), texture);
+		store.insert(sprite);
+		store.setSpeed(*sprite, v);
+		sprites.push_back(sprite);
+	}
+
+	for (const auto& sprite : sprites)
+		store.activate(*sprite);
+
+	double oldTime = measure([&oldBodies]() {
+		for (const auto& body : oldBodies)
+			body->shape.setPosition(body->shape.getPosition() +
+					body->speed * STEP_SECONDS);
+	}, STEPS);
+	double storeTime = measure([&store]() {
+		store.predict(STEP_SECONDS);
+		store.integrate();
+	}, STEPS);
+
+	// Both layouts have to end up at the same positions.
+	float difference = 0;
+	for (int i = 0; i < BODIES; i++) {
+		Vector2f d = oldBodies[i]->shape.getPosition() - sprites[i]->getPosition();
+		difference = std::max(difference, std::max(std::abs(d.x), std::abs(d.y)));
+	}
+	std::cout << BODIES << " bodies, " << STEPS << " steps" << std::endl;
+	std::cout << "separate objects: " << oldTime << " ms per step" << std::endl;
+	std::cout << "BodyStore:        " << storeTime << " ms per step" << std::endl;
+	std::cout << "largest position difference: " << difference << std::endl;
+
+	std::uniform_real_distribution<float> crowded(-1000.0f, 1000.0f);
+	std::vector<std::shared_ptr<Body> > oldSprites;
+	World world;
+	for (int i = 0; i < COLLISION_BODIES; i++) {
+		Vector2f p(crowded(generator), crowded(generator));
+		Vector2f v = (i % 2 == 0)
+				? Vector2f(speed(generator), speed(generator))
+				: Vector2f();
+		for (int j = 0; j < 2; j++) {
+			auto sprite = std::make_shared<Body>(p, Sprite::CATEGORY_NONSOLID,
+					Sprite::MASK_ALL, Vector2f(10, 10), texture);
+			sprite->setSpeed(v, thor::length(v));
+			if (j == 0)
+				oldSprites.push_back(sprite);
+			else
+				world.insert(sprite);
+		}
+	}
+	double oldCollisionTime = measure([&oldSprites]() {
+		stepOld(oldSprites);
+	}, COLLISION_STEPS);
+	double worldTime = measure([&world]() {
+		world.step(STEP_SECONDS * 1000);
+	}, COLLISION_STEPS);
+
+	std::cout << COLLISION_BODIES << " colliding sprites, half of them moving, " <<
+			COLLISION_STEPS << " steps" << std::endl;
+	std::cout << "brute force:      " << oldCollisionTime << " ms per step" << std::endl;
+	std::cout << "World::step:      " << worldTime << " ms per step" << std::endl;
+	return 0;
+}
@@ -0,0 +1,45 @@
+/*
+ * ConfigCompiler.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../src/util/ConfigBundle.h"
+
+/**
+ * Packs YAML config files into a bundle that the game reads at startup
+ * instead of parsing the files. Built separately from the game, together
+ * with src/util/ConfigBundle.cpp and src/util/Logger.cpp.
+ *
+ * @code
+ * ConfigCompiler res/config.bundle res/yaml/ res/yaml/<file>.yaml ...
+ * @endcode
+ *
+ * The bundle has to be recreated whenever a YAML file changes, or deleted
+ * to use the YAML files directly.
+ */
+int main(int argc, char* argv[]) {
+	if (argc < 4) {
+		std::cerr << "Usage: " << argv[0] << " <bundle> <folder> <file.yaml>..."
+				<< std::endl;
+		return 1;
+	}
+	std::string folder = argv[2];
+	std::vector<std::string> filenames;
+	for (int i = 3; i < argc; i++) {
+		std::string filename = argv[i];
+		// Files are found by their name relative to the folder.
+		if (filename.compare(0, folder.size(), folder) == 0)
+			filename = filename.substr(folder.size());
+		filenames.push_back(filename);
+	}
+	if (!ConfigBundle::write(argv[1], folder, filenames))
+		return 1;
+	std::cout << "Wrote " << filenames.size() << " files to " << argv[1]
+			<< std::endl;
+	return 0;
+}
@@ -0,0 +1,129 @@
+/*
+ * NoiseBenchmark.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "../src/generator/SimplexNoise.h"
+
+/**
+ * SimplexNoise::getNoise as it was before the cache was removed: every value
+ * is stored in a map of maps on first use and never released.
+ */
+class OldNoise {
+public:
+	explicit OldNoise(const SimplexNoise& noise) : mNoise(noise) {}
+
+	float getNoise(int x, int y) {
+		if (mCache.count(x) == 0 ||
+				mCache.at(x).count(y) == 0)
+			mCache[x][y] = mNoise.getNoise(x, y);
+		return mCache.at(x).at(y);
+	}
+
+private:
+	const SimplexNoise& mNoise;
+	std::map<int, std::map<int, float> > mCache;
+};
+
+/// Number of areas that are evaluated, each at a different position.
+static const int AREAS = 200;
+/// Width and height of each area in tiles.
+static const int AREA_SIZE = 64;
+
+/**
+ * Returns the position of area index, so that no two areas overlap.
+ */
+sf::IntRect
+getArea(int index) {
+	return sf::IntRect(index * AREA_SIZE, -index * AREA_SIZE, AREA_SIZE,
+			AREA_SIZE);
+}
+
+/**
+ * Returns millions of samples per second for calling evaluate on each area,
+ * which adds the values of the area to sum.
+ */
+template <typename F>
+double
+measure(F evaluate, double& sum) {
+	sum = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < AREAS; i++)
+		evaluate(getArea(i), sum);
+	double seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+	return AREAS * AREA_SIZE * AREA_SIZE / seconds / 1000000.0;
+}
+
+/**
+ * Evaluates AREAS areas of AREA_SIZE x AREA_SIZE noise values, like
+ * Generator does for tile and enemy generation, once through the old
+ * cached getNoise, once point by point with the scalar getNoise(int, int),
+ * and once with getNoise(const sf::IntRect&). The last one uses AVX2 or
+ * SSE2 depending on compile flags, so build the tool once for each path,
+ * together with src/generator/SimplexNoise.cpp:
+ *
+ * @code
+ * g++ -O2 -std=c++11 -msse2 tools/NoiseBenchmark.cpp src/generator/SimplexNoise.cpp
+ * g++ -O2 -std=c++11 -mavx2 tools/NoiseBenchmark.cpp src/generator/SimplexNoise.cpp
+ * @endcode
+ */
+int main() {
+	SimplexNoise noise;
+	OldNoise oldNoise(noise);
+
+	double oldSum;
+	double oldRate = measure([&oldNoise](const sf::IntRect& area, double& sum) {
+		for (int x = area.left; x < area.left + area.width; x++)
+			for (int y = area.top; y < area.top + area.height; y++)
+				sum += oldNoise.getNoise(x, y);
+	}, oldSum);
+	double scalarSum;
+	double scalarRate = measure([&noise](const sf::IntRect& area, double& sum) {
+		for (int x = area.left; x < area.left + area.width; x++)
+			for (int y = area.top; y < area.top + area.height; y++)
+				sum += noise.getNoise(x, y);
+	}, scalarSum);
+	double areaSum;
+	double areaRate = measure([&noise](const sf::IntRect& area, double& sum) {
+		for (float value : noise.getNoise(area))
+			sum += value;
+	}, areaSum);
+
+	// All paths have to produce the same values.
+	float difference = 0;
+	for (int i = 0; i < AREAS; i++) {
+		sf::IntRect area = getArea(i);
+		std::vector<float> values = noise.getNoise(area);
+		for (int y = 0; y < area.height; y++)
+			for (int x = 0; x < area.width; x++)
+				difference = std::max(difference, std::abs(
+						values[y * area.width + x] -
+						noise.getNoise(area.left + x, area.top + y)));
+	}
+
+#if defined(__AVX2__)
+	const char* path = "AVX2";
+#elif defined(__SSE2__)
+	const char* path = "SSE2";
+#else
+	const char* path = "scalar";
+#endif
+	std::cout << AREAS << " areas of " << AREA_SIZE << "x" << AREA_SIZE <<
+			" (sums " << oldSum << ", " << scalarSum << ", " << areaSum << ")" <<
+			std::endl;
+	std::cout << "old cached getNoise: " << oldRate << "M samples/s" << std::endl;
+	std::cout << "scalar getNoise:     " << scalarRate << "M samples/s" << std::endl;
+	std::cout << "area getNoise (" << path << "): " << areaRate <<
+			"M samples/s" << std::endl;
+	std::cout << "largest difference to scalar: " << difference << std::endl;
+	return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * TraceStats.cpp
+ *
+ *  Created on: 19.10.2026
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+#include "../src/util/Trace.h"
+
+/**
+ * Event counts and durations of a single frame.
+ */
+struct FrameStats {
+	int elapsed = 0;
+	int counts[Trace::EVENT_COUNT] = {};
+	float damage = 0;
+	float pathMicroseconds = 0;
+	float generateMilliseconds = 0;
+};
+
+/**
+ * Converts a trace written with the game's --trace option into one CSV line
+ * per frame (on stdout), followed by totals (on stderr). Built separately
+ * from the game, together with src/util/Trace.cpp and src/util/Logger.cpp.
+ *
+ * @code
+ * TraceStats session.trace > session.csv
+ * @endcode
+ */
+int main(int argc, char* argv[]) {
+	if (argc != 2) {
+		std::cerr << "Usage: " << argv[0] << " <file.trace>" << std::endl;
+		return 1;
+	}
+	std::ifstream file(argv[1], std::ios::binary);
+	Trace::Header header;
+	if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+			std::memcmp(header.magic, Trace::MAGIC, sizeof(header.magic)) != 0) {
+		std::cerr << argv[1] << " is not a trace file" << std::endl;
+		return 1;
+	}
+	if (header.version != Trace::VERSION ||
+			header.recordSize != sizeof(Trace::Record)) {
+		std::cerr << argv[1] << " has unsupported version " << header.version
+				<< std::endl;
+		return 1;
+	}
+
+	std::map<unsigned int, FrameStats> frames;
+	Trace::Record record;
+	size_t records = 0;
+	while (file.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+		records++;
+		if (record.type >= Trace::EVENT_COUNT)
+			continue;
+		FrameStats& frame = frames[record.frame];
+		frame.counts[record.type]++;
+		switch (record.type) {
+		case Trace::FRAME:
+			frame.elapsed = record.first;
+			break;
+		case Trace::DAMAGE:
+			frame.damage += record.x;
+			break;
+		case Trace::PATH:
+			frame.pathMicroseconds += record.x;
+			break;
+		case Trace::GENERATE_TILES:
+			frame.generateMilliseconds += record.x;
+			break;
+		default:
+			break;
+		}
+	}
+
+	std::cout << "frame,elapsed_ms,collisions,bullet_hits,damage_events,damage,"
+			"deaths,shots,paths,path_us,generated_areas,generate_ms\n";
+	FrameStats total;
+	for (const auto& frame : frames) {
+		const FrameStats& f = frame.second;
+		std::cout << frame.first << "," << f.elapsed << ","
+				<< f.counts[Trace::COLLISION] << "," << f.counts[Trace::BULLET_HIT] << ","
+				<< f.counts[Trace::DAMAGE] << "," << f.damage << ","
+				<< f.counts[Trace::DEATH] << "," << f.counts[Trace::FIRE] << ","
+				<< f.counts[Trace::PATH] << "," << f.pathMicroseconds << ","
+				<< f.counts[Trace::GENERATE_TILES] << "," << f.generateMilliseconds
+				<< "\n";
+		total.elapsed += f.elapsed;
+		for (int i = 0; i < Trace::EVENT_COUNT; i++)
+			total.counts[i] += f.counts[i];
+		total.damage += f.damage;
+		total.pathMicroseconds += f.pathMicroseconds;
+		total.generateMilliseconds += f.generateMilliseconds;
+	}
+
+	std::cerr << records << " events in " << frames.size() << " frames, "
+			<< total.elapsed / 1000.0f << " s\n"
+			<< "average frame " << ((frames.empty()) ? 0 : total.elapsed / (float) frames.size())
+			<< " ms\n"
+			<< "collisions " << total.counts[Trace::COLLISION]
+			<< ", bullet hits " << total.counts[Trace::BULLET_HIT]
+			<< ", shots " << total.counts[Trace::FIRE]
+			<< ", deaths " << total.counts[Trace::DEATH] << "\n"
+			<< "paths " << total.counts[Trace::PATH] << ", average "
+			<< ((total.counts[Trace::PATH] == 0)
+					? 0 : total.pathMicroseconds / total.counts[Trace::PATH])
+			<< " us\n"
+			<< "generated areas " << total.counts[Trace::GENERATE_TILES]
+			<< " in " << total.generateMilliseconds << " ms" << std::endl;
+	return 0;
+}